@@ -0,0 +1,57 @@
+#include "AsciiCase.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ASCII_CASE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef ASCII_CASE_SSE2
+
+namespace {
+
+// 0xFF for every byte in 'A'..'Z'. Bytes >= 0x80 compare as negative and never match.
+inline __m128i upperMask16(__m128i v) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+}
+
+} // namespace
+
+#endif // ASCII_CASE_SSE2
+
+size_t findUpperAscii(const char* data, size_t size) {
+    size_t i = 0;
+#ifdef ASCII_CASE_SSE2
+    for (; i + 16 <= size; i += 16) {
+        const unsigned mask =
+            static_cast<unsigned>(_mm_movemask_epi8(upperMask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)))));
+        if (mask != 0) {
+            for (unsigned bit = 0;; ++bit) {
+                if (mask & (1u << bit)) {
+                    return i + bit;
+                }
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] >= 'A' && data[i] <= 'Z') {
+            return i;
+        }
+    }
+    return size;
+}
+
+void foldAsciiCopy(const char* src, size_t size, char* dst) {
+    size_t i = 0;
+#ifdef ASCII_CASE_SSE2
+    // Set the 0x20 bit of the upper-case letters.
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i folded = _mm_or_si128(v, _mm_and_si128(upperMask16(v), _mm_set1_epi8(0x20)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), folded);
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[i] = foldAscii(src[i]);
+    }
+}
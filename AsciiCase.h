@@ -0,0 +1,61 @@
+#ifndef ASCII_CASE_H
+#define ASCII_CASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ASCII case folding shared by every case-insensitive path (parser, finders, patterns, indexes).
+// Only 'A'..'Z' are folded; other bytes, including non-ASCII ones, are compared as they are,
+// independently of the current C locale. Nothing here allocates.
+
+struct AsciiFoldTable {
+    char map[256];
+};
+
+constexpr AsciiFoldTable makeAsciiFoldTable() {
+    AsciiFoldTable table{};
+    for (int i = 0; i < 256; ++i) {
+        table.map[i] = static_cast<char>((i >= 'A' && i <= 'Z') ? i - 'A' + 'a' : i);
+    }
+    return table;
+}
+
+inline constexpr AsciiFoldTable kAsciiFoldTable = makeAsciiFoldTable();
+
+constexpr char foldAscii(char c) { return kAsciiFoldTable.map[static_cast<unsigned char>(c)]; }
+
+// Case-insensitive equality, folding on the fly.
+constexpr bool equalsFolded(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (foldAscii(a[i]) != foldAscii(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline constexpr uint64_t kFnv1aBasis = 14695981039346656037ull;
+inline constexpr uint64_t kFnv1aPrime = 1099511628211ull;
+
+// FNV-1a hash of the bytes of s, folded first when fold is set, so that names differing only in
+// case hash alike. A different basis gives an independent hash (seeded tables).
+constexpr uint64_t hashFolded(std::string_view s, bool fold, uint64_t basis = kFnv1aBasis) {
+    uint64_t hash = basis;
+    for (const char c : s) {
+        hash ^= static_cast<unsigned char>(fold ? foldAscii(c) : c);
+        hash *= kFnv1aPrime;
+    }
+    return hash;
+}
+
+// Index of the first 'A'..'Z' byte in [data, data + size), or size if there is none.
+size_t findUpperAscii(const char* data, size_t size);
+
+// Write the folded bytes of [src, src + size) to dst (which may be src).
+void foldAsciiCopy(const char* src, size_t size, char* dst);
+
+#endif // ASCII_CASE_H
@@ -0,0 +1,39 @@
+#include "AsciiCase.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(AsciiCaseTest, FoldsOnlyAsciiLetters) {
+    for (int i = 0; i < 256; ++i) {
+        const char c = static_cast<char>(i);
+        const char expected = (i >= 'A' && i <= 'Z') ? static_cast<char>(i + 32) : c;
+        EXPECT_EQ(foldAscii(c), expected) << i;
+    }
+    EXPECT_TRUE(equalsFolded("Com.Example", "cOM.eXAMPLE"));
+    EXPECT_FALSE(equalsFolded("abc", "abd"));
+    EXPECT_FALSE(equalsFolded("abc", "ab"));
+    EXPECT_FALSE(equalsFolded("\xC0", "\xE0")); // not ASCII
+}
+
+TEST(AsciiCaseTest, BulkFindAndFold) {
+    // every length and position around the 16-byte blocks, with non-ASCII bytes around
+    for (size_t size = 0; size < 40; ++size) {
+        for (size_t upper = 0; upper <= size; ++upper) {
+            std::string s(size, '\xDA');
+            for (size_t i = 0; i < size; i += 3) {
+                s[i] = 'z';
+            }
+            if (upper < size) {
+                s[upper] = 'Q';
+            }
+            EXPECT_EQ(findUpperAscii(s.data(), s.size()), upper);
+
+            std::string folded(size, '\0');
+            foldAsciiCopy(s.data(), s.size(), &folded[0]);
+            std::string expected = s;
+            for (char& c : expected) {
+                c = foldAscii(c);
+            }
+            EXPECT_EQ(folded, expected);
+        }
+    }
+}
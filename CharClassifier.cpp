@@ -0,0 +1,113 @@
+#include "CharClassifier.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHAR_CLASSIFIER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(CHAR_CLASSIFIER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define CHAR_CLASSIFIER_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const char* findSpecialCharScalar(const char* begin, const char* end) {
+    while (begin < end && !isSpecialChar(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+#ifdef CHAR_CLASSIFIER_SSE2
+
+inline unsigned specialMask16(__m128i v) {
+    __m128i m = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(';')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('=')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('#')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    return static_cast<unsigned>(_mm_movemask_epi8(m));
+}
+
+inline unsigned countTrailingZeros(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned n = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+const char* findSpecialCharSse2(const char* begin, const char* end) {
+    while (end - begin >= 16) {
+        const unsigned mask = specialMask16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin)));
+        if (mask != 0) {
+            return begin + countTrailingZeros(mask);
+        }
+        begin += 16;
+    }
+    return findSpecialCharScalar(begin, end);
+}
+
+#endif // CHAR_CLASSIFIER_SSE2
+
+#ifdef CHAR_CLASSIFIER_AVX2
+
+__attribute__((target("avx2"))) const char* findSpecialCharAvx2(const char* begin, const char* end) {
+    while (end - begin >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(';')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('=')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('#')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(m));
+        if (mask != 0) {
+            return begin + __builtin_ctz(mask);
+        }
+        begin += 32;
+    }
+    return findSpecialCharSse2(begin, end);
+}
+
+#endif // CHAR_CLASSIFIER_AVX2
+
+using FindSpecialCharFn = const char* (*)(const char*, const char*);
+
+FindSpecialCharFn selectFindSpecialChar() {
+#ifdef CHAR_CLASSIFIER_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return findSpecialCharAvx2;
+    }
+#endif
+#ifdef CHAR_CLASSIFIER_SSE2
+    return findSpecialCharSse2;
+#else
+    return findSpecialCharScalar;
+#endif
+}
+
+} // namespace
+
+const char* findSpecialChar(const char* begin, const char* end) {
+    static const FindSpecialCharFn impl = selectFindSpecialChar();
+    return impl(begin, end);
+}
@@ -0,0 +1,32 @@
+#ifndef CHAR_CLASSIFIER_H
+#define CHAR_CLASSIFIER_H
+
+#include <cstddef>
+
+// Bytes that can change the tokenizer state: '\n' '\r' ';' '=' '"' '\\' '#' '/' '*', space and tab.
+// Everything else is ordinary key/value text and can be skipped in bulk.
+inline bool isSpecialChar(char c) {
+    switch (c) {
+    case '\n':
+    case '\r':
+    case ';':
+    case '=':
+    case '"':
+    case '\\':
+    case '#':
+    case '/':
+    case '*':
+    case ' ':
+    case '\t':
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Returns a pointer to the first special byte in [begin, end), or end if there is none.
+// Scans 32 bytes at a time with AVX2 when the CPU supports it, 16 bytes at a time with SSE2
+// otherwise, and falls back to a scalar loop on other targets.
+const char* findSpecialChar(const char* begin, const char* end);
+
+#endif // CHAR_CLASSIFIER_H
@@ -0,0 +1,52 @@
+#include "CharClassifier.h"
+#include <gtest/gtest.h>
+#include <string>
+
+static const char* findSpecialCharReference(const char* begin, const char* end) {
+    while (begin < end && !isSpecialChar(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+TEST(CharClassifierTest, SpecialCharacterSet) {
+    const std::string special = "\n\r;=\"\\#/* \t";
+    for (int c = 0; c < 256; ++c) {
+        EXPECT_EQ(isSpecialChar(static_cast<char>(c)), special.find(static_cast<char>(c)) != std::string::npos) << c;
+    }
+}
+
+TEST(CharClassifierTest, NoSpecialCharacterReturnsEnd) {
+    const std::string text(100, 'a');
+    EXPECT_EQ(findSpecialChar(text.data(), text.data() + text.size()), text.data() + text.size());
+    EXPECT_EQ(findSpecialChar(text.data(), text.data()), text.data());
+}
+
+// Every special byte at every position of blocks that cover the 32/16-byte and scalar tails.
+TEST(CharClassifierTest, FindsFirstSpecialCharacterAtAnyPosition) {
+    const std::string special = "\n\r;=\"\\#/* \t";
+    for (size_t length = 1; length <= 80; ++length) {
+        for (size_t pos = 0; pos < length; ++pos) {
+            for (char c : special) {
+                std::string text(length, 'x');
+                text[pos] = c;
+                if (pos + 1 < length) {
+                    text[length - 1] = '=';
+                }
+                const char* begin = text.data();
+                const char* end = text.data() + text.size();
+                ASSERT_EQ(findSpecialChar(begin, end), findSpecialCharReference(begin, end)) << length << " " << pos;
+                ASSERT_EQ(findSpecialChar(begin + 1, end), findSpecialCharReference(begin + 1, end));
+            }
+        }
+    }
+}
+
+TEST(CharClassifierTest, HighBytesAreOrdinary) {
+    std::string text;
+    for (int c = 128; c < 256; ++c) {
+        text.push_back(static_cast<char>(c));
+    }
+    text.push_back(';');
+    EXPECT_EQ(findSpecialChar(text.data(), text.data() + text.size()), text.data() + text.size() - 1);
+}
@@ -0,0 +1,127 @@
+#include "CompiledPattern.h"
+
+#include "AsciiCase.h"
+
+#include <cstring>
+
+CompiledPattern::CompiledPattern(std::string_view pattern, bool caseSensitive) : m_caseSensitive(caseSensitive) {
+    m_pattern.reserve(pattern.size());
+    for (const char c : pattern) {
+        if (c == '*' && !m_pattern.empty() && m_pattern.back() == '*') {
+            continue; // "**" matches the same as "*"
+        }
+        m_pattern.push_back(caseSensitive ? c : foldAscii(c));
+    }
+
+    size_t start = 0;
+    while (true) {
+        const size_t star = m_pattern.find('*', start);
+        const size_t end = (star == std::string::npos) ? m_pattern.size() : star;
+
+        Segment segment{start, end - start, end - start, false};
+        for (size_t i = start; i < end; ++i) {
+            if (m_pattern[i] == '?') {
+                segment.hasQuestion = true;
+            } else if (segment.anchor == segment.length) {
+                segment.anchor = i - start;
+            }
+        }
+        m_segments.push_back(segment);
+        m_minLength += segment.length;
+
+        if (star == std::string::npos) {
+            break;
+        }
+        m_hasStar = true;
+        start = star + 1;
+    }
+}
+
+bool CompiledPattern::segmentMatchesAt(const Segment& segment, const char* str) const {
+    const char* pattern = m_pattern.data() + segment.offset;
+    for (size_t i = 0; i < segment.length; ++i) {
+        const char p = pattern[i];
+        if (p == '?') {
+            continue;
+        }
+        if (p != (m_caseSensitive ? str[i] : foldAscii(str[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* CompiledPattern::findSegment(const Segment& segment, const char* begin, const char* end) const {
+    if (static_cast<size_t>(end - begin) < segment.length) {
+        return nullptr;
+    }
+    if (segment.anchor == segment.length) {
+        return begin; // only '?': any position fits
+    }
+
+    const char* pattern = m_pattern.data() + segment.offset;
+    if (m_caseSensitive && !segment.hasQuestion) {
+        const std::string_view haystack(begin, static_cast<size_t>(end - begin));
+        const size_t pos = haystack.find(std::string_view(pattern, segment.length));
+        return (pos == std::string_view::npos) ? nullptr : begin + pos;
+    }
+
+    // Jump between occurrences of the anchor character and verify the segment there.
+    const char anchor = pattern[segment.anchor];
+    const bool anchorHasCase = !m_caseSensitive && anchor >= 'a' && anchor <= 'z';
+    const char* last = end - segment.length;
+    for (const char* p = begin; p <= last; ++p) {
+        const char* from = p + segment.anchor;
+        const char* to = last + segment.anchor + 1;
+        const char* found = nullptr;
+        if (anchorHasCase) {
+            for (const char* q = from; q < to; ++q) {
+                if (foldAscii(*q) == anchor) {
+                    found = q;
+                    break;
+                }
+            }
+        } else {
+            found = static_cast<const char*>(std::memchr(from, anchor, static_cast<size_t>(to - from)));
+        }
+        if (!found) {
+            return nullptr;
+        }
+        p = found - segment.anchor;
+        if (segmentMatchesAt(segment, p)) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+bool CompiledPattern::matches(std::string_view str) const {
+    const char* begin = str.data();
+    const char* end = str.data() + str.size();
+
+    if (!m_hasStar) {
+        return str.size() == m_minLength && segmentMatchesAt(m_segments.front(), begin);
+    }
+    if (str.size() < m_minLength) {
+        return false;
+    }
+
+    // Literal prefix and suffix reject most strings before any search.
+    const Segment& prefix = m_segments.front();
+    const Segment& suffix = m_segments.back();
+    if (!segmentMatchesAt(prefix, begin) || !segmentMatchesAt(suffix, end - suffix.length)) {
+        return false;
+    }
+
+    // Segments between stars: the leftmost occurrence of each one leaves the most room for the rest.
+    const char* pos = begin + prefix.length;
+    const char* limit = end - suffix.length;
+    for (size_t i = 1; i + 1 < m_segments.size(); ++i) {
+        const char* found = findSegment(m_segments[i], pos, limit);
+        if (!found) {
+            return false;
+        }
+        pos = found + m_segments[i].length;
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef COMPILED_PATTERN_H
+#define COMPILED_PATTERN_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A GWT-style pattern ('*' - any sequence, '?' - exactly one character) prepared once for
+// matching many strings: the pattern is case-folded up front, runs of '*' are collapsed and it is
+// split into the literal segments between stars. Matching allocates nothing.
+class CompiledPattern {
+public:
+    explicit CompiledPattern(std::string_view pattern, bool caseSensitive = true);
+
+    // Same result as PropertyParser::matchesPattern(str, pattern, caseSensitive).
+    bool matches(std::string_view str) const;
+
+    // Folded pattern with '*' runs collapsed
+    const std::string& pattern() const { return m_pattern; }
+    bool isCaseSensitive() const { return m_caseSensitive; }
+
+private:
+    // Part of m_pattern between two stars (may contain '?').
+    struct Segment {
+        size_t offset;
+        size_t length;
+        size_t anchor; // index of the first literal (non-'?') character, length if none
+        bool hasQuestion;
+    };
+
+    std::string m_pattern;
+    bool m_caseSensitive{true};
+    bool m_hasStar{false};
+
+    // Without stars m_segments holds the whole pattern. With stars the first segment is the
+    // literal prefix and the last one the literal suffix (both may be empty).
+    std::vector<Segment> m_segments;
+    size_t m_minLength{0}; // characters a matching string needs besides the stars
+
+    bool segmentMatchesAt(const Segment& segment, const char* str) const;
+    const char* findSegment(const Segment& segment, const char* begin, const char* end) const;
+};
+
+#endif // COMPILED_PATTERN_H
@@ -0,0 +1,45 @@
+#include "CompiledPattern.h"
+#include "PropertyParser.h"
+#include <gtest/gtest.h>
+
+TEST(CompiledPatternTest, MatchesLikeMatchesPattern) {
+    const char* patterns[] = {"", "*", "?", "***", "com.example.*", "*.MyTest", "My?est", "com.*.My?e??", "com.**.MyTest",
+                              "a*b*c", "*a?b*", "??*??", "*.*.*"};
+    const char* strings[] = {"", "a", "abc", "aXbYc", "com.example.MyTest", "com.Example.MyTest", "com.example.subpackage.MyTest",
+                             "MyTest", "very.long.package.name.MyTest", "xaybz", "a.b", "COM.EXAMPLE.SUBPACKAGE.MYTEST"};
+
+    for (const char* pattern : patterns) {
+        for (bool caseSensitive : {true, false}) {
+            const CompiledPattern compiled(pattern, caseSensitive);
+            for (const char* str : strings) {
+                EXPECT_EQ(compiled.matches(str), PropertyParser::matchesPattern(str, pattern, caseSensitive))
+                    << "pattern='" << pattern << "' str='" << str << "' caseSensitive=" << caseSensitive;
+            }
+        }
+    }
+}
+
+TEST(CompiledPatternTest, CollapsesStarsAndFoldsCase) {
+    const CompiledPattern compiled("COM.**.*Test", false);
+    EXPECT_EQ(compiled.pattern(), "com.*.*test");
+    EXPECT_FALSE(compiled.isCaseSensitive());
+    EXPECT_TRUE(compiled.matches("com.Example.MyTEST"));
+    EXPECT_FALSE(compiled.matches("com.MyTest"));
+}
+
+TEST(CompiledPatternTest, PrefixAndSuffixReject) {
+    const CompiledPattern compiled("abc*xyz");
+    EXPECT_TRUE(compiled.matches("abcxyz"));
+    EXPECT_TRUE(compiled.matches("abc-middle-xyz"));
+    EXPECT_FALSE(compiled.matches("abxyz"));
+    EXPECT_FALSE(compiled.matches("abc-middle-xy"));
+    EXPECT_FALSE(compiled.matches("abcxy"));
+}
+
+TEST(CompiledPatternTest, MiddleSegmentsWithQuestionMarks) {
+    const CompiledPattern compiled("*a?c*a?c*", false);
+    EXPECT_TRUE(compiled.matches("xxAbCyyaxc"));
+    EXPECT_FALSE(compiled.matches("xxAbCyy"));
+    EXPECT_TRUE(compiled.matches("abcabc"));
+    EXPECT_FALSE(compiled.matches("abcab"));
+}
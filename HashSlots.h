@@ -0,0 +1,77 @@
+#ifndef HASH_SLOTS_H
+#define HASH_SLOTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing slots of the name tables (PropertyIndex, PropertyNameTable, PropertySnapshot).
+// Entries live in the owner's array under dense indices 0, 1, 2, ...; a slot holds an entry index + 1,
+// or 0 when empty. The slot count is a power of two and the table is kept at most half full, so a
+// linear probe always ends at an empty slot.
+
+// Probe slots[0, slotCount) for hash: returns the slot of the first entry for which matches(index)
+// is true, or the empty slot where the probe ended. Returns slotCount if every slot was probed
+// (only possible for slots that do not come from HashSlots, e.g. a damaged file image).
+template <class Matches>
+size_t probeHashSlots(const uint32_t* slots, size_t slotCount, uint64_t hash, Matches&& matches) {
+    const size_t mask = slotCount - 1;
+    size_t slot = static_cast<size_t>(hash) & mask;
+    for (size_t probes = 0; probes < slotCount; ++probes, slot = (slot + 1) & mask) {
+        if (slots[slot] == 0 || matches(slots[slot] - 1)) {
+            return slot;
+        }
+    }
+    return slotCount;
+}
+
+class HashSlots {
+public:
+    // Room for capacity entries before the first growth.
+    explicit HashSlots(size_t capacity = 0) { clear(capacity); }
+
+    void clear(size_t capacity = 0) {
+        size_t slotCount = 16;
+        while (slotCount < capacity * 2) {
+            slotCount *= 2;
+        }
+        m_slots.assign(slotCount, 0);
+        m_count = 0;
+    }
+
+    // See probeHashSlots(); a table built here always has an empty slot.
+    template <class Matches>
+    size_t probe(uint64_t hash, Matches&& matches) const {
+        return probeHashSlots(m_slots.data(), m_slots.size(), hash, matches);
+    }
+
+    // Entry index + 1 at slot, 0 if it is empty.
+    uint32_t at(size_t slot) const { return m_slots[slot]; }
+
+    // Store the next entry index (the number of entries so far) at the empty slot returned by probe().
+    // Growing rehashes entries 0 .. size() - 1 with hashOf(index).
+    template <class HashOf>
+    void insert(size_t slot, HashOf&& hashOf) {
+        m_slots[slot] = static_cast<uint32_t>(++m_count);
+        if (m_count * 2 > m_slots.size()) {
+            m_slots.assign(m_slots.size() * 2, 0);
+            const size_t mask = m_slots.size() - 1;
+            for (size_t index = 0; index < m_count; ++index) {
+                size_t s = static_cast<size_t>(hashOf(index)) & mask;
+                while (m_slots[s] != 0) {
+                    s = (s + 1) & mask;
+                }
+                m_slots[s] = static_cast<uint32_t>(index + 1);
+            }
+        }
+    }
+
+    size_t size() const { return m_count; }
+    const std::vector<uint32_t>& slots() const { return m_slots; }
+
+private:
+    std::vector<uint32_t> m_slots;
+    size_t m_count{0};
+};
+
+#endif // HASH_SLOTS_H
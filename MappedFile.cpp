@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_open = other.m_open;
+        m_mapped = other.m_mapped;
+        m_size = other.m_size;
+        m_contents = std::move(other.m_contents);
+        m_data = m_mapped ? other.m_data : m_contents.data();
+
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_open = false;
+        other.m_mapped = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path, bool sequential) {
+    close();
+
+#ifdef MAPPED_FILE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size > 0) {
+        void* mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        ::madvise(mapping, static_cast<size_t>(st.st_size), sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        m_data = static_cast<const char*>(mapping);
+        m_size = static_cast<size_t>(st.st_size);
+        m_mapped = true;
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+#else
+    (void)sequential;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    m_contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_data = m_contents.data();
+    m_size = m_contents.size();
+#endif
+
+    m_open = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_MMAP
+    if (m_mapped) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_contents.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_mapped = false;
+}
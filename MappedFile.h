@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only view of a whole file. On POSIX systems the file is mapped with mmap() and marked for
+// sequential access, so its contents are paged in on demand instead of being read and copied;
+// elsewhere it is read into memory. The contents stay valid until the file is closed.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Open (and map) a file, closing the previous one. Returns false if it cannot be read.
+    // sequential selects the access pattern hint: read once front to back, or random lookups.
+    bool open(const std::string& path, bool sequential = true);
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    bool m_open{false};
+    bool m_mapped{false};   // m_data is a mapping to unmap on close
+    std::string m_contents; // contents when the file is not mapped
+};
+
+#endif // MAPPED_FILE_H
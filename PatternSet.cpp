@@ -0,0 +1,144 @@
+#include "PatternSet.h"
+
+#include "AsciiCase.h"
+
+#include <algorithm>
+
+namespace {
+
+inline void sortUnique(std::vector<uint32_t>& v) {
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+} // namespace
+
+PatternSet::PatternSet(bool caseSensitive) : m_caseSensitive(caseSensitive) { m_nodes.emplace_back(); }
+
+size_t PatternSet::add(std::string_view pattern) {
+    uint32_t node = 0;
+    for (const char c : pattern) {
+        if (c == '*') {
+            if (m_nodes[node].isStar) {
+                continue; // "**" matches the same as "*"
+            }
+            if (m_nodes[node].star == kNone) {
+                m_nodes[node].star = static_cast<uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+                m_nodes.back().isStar = true;
+            }
+            node = m_nodes[node].star;
+            continue;
+        }
+
+        const char label = m_caseSensitive ? c : foldAscii(c);
+        uint32_t child = kNone;
+        for (const auto& edge : m_nodes[node].children) {
+            if (edge.first == label) {
+                child = edge.second;
+                break;
+            }
+        }
+        if (child == kNone) {
+            child = static_cast<uint32_t>(m_nodes.size());
+            m_nodes[node].children.emplace_back(label, child);
+            m_nodes.emplace_back();
+        }
+        node = child;
+    }
+
+    const size_t id = m_patternCount++;
+    m_nodes[node].patternIds.push_back(static_cast<uint32_t>(id));
+
+    // The cached DFA does not know the new pattern.
+    m_states.clear();
+    m_stateIds.clear();
+    return id;
+}
+
+void PatternSet::addClosure(uint32_t node, std::vector<uint32_t>& set) const {
+    // A star also matches the empty sequence: the node after it is active at the same time.
+    while (node != kNone) {
+        set.push_back(node);
+        node = m_nodes[node].star;
+    }
+}
+
+int32_t PatternSet::stateFor(std::vector<uint32_t>& nodes) {
+    sortUnique(nodes);
+    const auto it = m_stateIds.find(nodes);
+    if (it != m_stateIds.end()) {
+        return it->second;
+    }
+
+    State state;
+    std::fill(std::begin(state.next), std::end(state.next), -1);
+    for (const uint32_t node : nodes) {
+        const auto& ids = m_nodes[node].patternIds;
+        state.patternIds.insert(state.patternIds.end(), ids.begin(), ids.end());
+    }
+    sortUnique(state.patternIds);
+    state.nodes = nodes;
+
+    const int32_t id = static_cast<int32_t>(m_states.size());
+    m_states.push_back(std::move(state));
+    m_stateIds.emplace(nodes, id);
+    return id;
+}
+
+int32_t PatternSet::transition(int32_t state, unsigned char byte) {
+    const int32_t cached = m_states[state].next[byte];
+    if (cached >= 0) {
+        return cached;
+    }
+
+    const char c = m_caseSensitive ? static_cast<char>(byte) : foldAscii(static_cast<char>(byte));
+    std::vector<uint32_t> nodes;
+    for (const uint32_t node : m_states[state].nodes) {
+        if (m_nodes[node].isStar) {
+            addClosure(node, nodes);
+        }
+        for (const auto& edge : m_nodes[node].children) {
+            if (edge.first == c || edge.first == '?') {
+                addClosure(edge.second, nodes);
+            }
+        }
+    }
+
+    const int32_t next = stateFor(nodes);
+    m_states[state].next[byte] = next;
+    return next;
+}
+
+int32_t PatternSet::run(std::string_view key) {
+    if (m_states.size() > kMaxStates) {
+        m_states.clear();
+        m_stateIds.clear();
+    }
+
+    std::vector<uint32_t> start;
+    int32_t state = 0;
+    if (m_states.empty()) {
+        addClosure(0, start);
+        state = stateFor(start); // always state 0
+    }
+
+    for (const char c : key) {
+        state = transition(state, static_cast<unsigned char>(c));
+        if (m_states[state].nodes.empty()) {
+            break; // no pattern can match anymore
+        }
+    }
+    return state;
+}
+
+bool PatternSet::matchAll(std::string_view key, std::vector<size_t>& ids) {
+    const std::vector<uint32_t>& matched = m_states[run(key)].patternIds;
+    ids.assign(matched.begin(), matched.end());
+    return !ids.empty();
+}
+
+size_t PatternSet::matchFirst(std::string_view key) {
+    const std::vector<uint32_t>& matched = m_states[run(key)].patternIds;
+    return matched.empty() ? npos : matched.front();
+}
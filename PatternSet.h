@@ -0,0 +1,65 @@
+#ifndef PATTERN_SET_H
+#define PATTERN_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <vector>
+
+// Many GWT-style patterns ('*' - any sequence, '?' - exactly one character) matched against a key
+// in a single pass. The patterns share a trie; matching walks a DFA over sets of trie nodes that is
+// built lazily, one transition at a time, and cached for the following keys.
+// Results are the same as PropertyParser::matchesPattern() called for every pattern.
+// Matching updates the cache, so a PatternSet must not be used from several threads at once.
+class PatternSet {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit PatternSet(bool caseSensitive = true);
+
+    // Add a pattern. IDs are assigned in insertion order starting from 0.
+    size_t add(std::string_view pattern);
+
+    size_t size() const { return m_patternCount; }
+    bool isCaseSensitive() const { return m_caseSensitive; }
+
+    // Fill ids with the IDs of all patterns matching key (ascending). Returns false if none matches.
+    bool matchAll(std::string_view key, std::vector<size_t>& ids);
+
+    // ID of the first added pattern matching key, or npos.
+    size_t matchFirst(std::string_view key);
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children; // literal characters and '?'
+        uint32_t star{kNone};                          // child reached through '*'
+        bool isStar{false};                            // reached through '*': consumes any character
+        std::vector<uint32_t> patternIds;              // patterns ending here
+    };
+
+    struct State {
+        std::vector<uint32_t> nodes;      // sorted set of trie nodes, closed over '*' children
+        std::vector<uint32_t> patternIds; // sorted IDs of the patterns accepted in this state
+        int32_t next[256];                // transitions by input byte, -1 until computed
+    };
+
+    // Cached DFA states are dropped when there are more than this many.
+    static constexpr size_t kMaxStates = 4096;
+
+    bool m_caseSensitive;
+    size_t m_patternCount{0};
+    std::vector<Node> m_nodes;
+
+    std::vector<State> m_states;
+    std::map<std::vector<uint32_t>, int32_t> m_stateIds;
+
+    void addClosure(uint32_t node, std::vector<uint32_t>& set) const;
+    int32_t stateFor(std::vector<uint32_t>& nodes);
+    int32_t transition(int32_t state, unsigned char byte);
+    int32_t run(std::string_view key);
+};
+
+#endif // PATTERN_SET_H
@@ -0,0 +1,94 @@
+#include "PatternSet.h"
+#include "PropertyParser.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(PatternSetTest, MatchAllAndFirst) {
+    PatternSet set;
+    EXPECT_EQ(set.add("com.example.*"), 0u);
+    EXPECT_EQ(set.add("*.MyTest"), 1u);
+    EXPECT_EQ(set.add("My?est"), 2u);
+    EXPECT_EQ(set.add("com.**.MyTest"), 3u);
+    EXPECT_EQ(set.size(), 4u);
+
+    std::vector<size_t> ids;
+    EXPECT_TRUE(set.matchAll("com.example.MyTest", ids));
+    EXPECT_EQ(ids, (std::vector<size_t>{0, 1, 3}));
+    EXPECT_EQ(set.matchFirst("com.example.MyTest"), 0u);
+
+    EXPECT_TRUE(set.matchAll("MyTest", ids));
+    EXPECT_EQ(ids, (std::vector<size_t>{2}));
+
+    EXPECT_FALSE(set.matchAll("org.Other", ids));
+    EXPECT_TRUE(ids.empty());
+    EXPECT_EQ(set.matchFirst("org.Other"), PatternSet::npos);
+}
+
+TEST(PatternSetTest, CaseInsensitive) {
+    PatternSet set(false);
+    set.add("COM.example.*");
+    set.add("*.mytest");
+
+    std::vector<size_t> ids;
+    EXPECT_TRUE(set.matchAll("com.Example.MyTest", ids));
+    EXPECT_EQ(ids, (std::vector<size_t>{0, 1}));
+}
+
+TEST(PatternSetTest, EmptyPatternAndKey) {
+    PatternSet set;
+    set.add("");
+    set.add("*");
+    set.add("?");
+
+    std::vector<size_t> ids;
+    EXPECT_TRUE(set.matchAll("", ids));
+    EXPECT_EQ(ids, (std::vector<size_t>{0, 1}));
+    EXPECT_TRUE(set.matchAll("x", ids));
+    EXPECT_EQ(ids, (std::vector<size_t>{1, 2}));
+}
+
+// Every key against many random patterns: the set must agree with matchesPattern() one by one,
+// including after patterns are added between matches.
+TEST(PatternSetTest, AgreesWithMatchesPattern) {
+    std::mt19937 rng(12345);
+    const char patternChars[] = "abAB*?.";
+    const char keyChars[] = "abAB.?*";
+
+    for (bool caseSensitive : {true, false}) {
+        PatternSet set(caseSensitive);
+        std::vector<std::string> patterns;
+        for (int round = 0; round < 4; ++round) {
+            for (int i = 0; i < 100; ++i) {
+                std::string pattern;
+                const int length = static_cast<int>(rng() % 8);
+                for (int j = 0; j < length; ++j) {
+                    pattern.push_back(patternChars[rng() % 7]);
+                }
+                patterns.push_back(pattern);
+                set.add(pattern);
+            }
+
+            for (int k = 0; k < 300; ++k) {
+                std::string key;
+                const int length = static_cast<int>(rng() % 10);
+                for (int j = 0; j < length; ++j) {
+                    key.push_back(keyChars[rng() % 7]);
+                }
+
+                std::vector<size_t> expected;
+                for (size_t id = 0; id < patterns.size(); ++id) {
+                    if (PropertyParser::matchesPattern(key, patterns[id], caseSensitive)) {
+                        expected.push_back(id);
+                    }
+                }
+
+                std::vector<size_t> ids;
+                EXPECT_EQ(set.matchAll(key, ids), !expected.empty());
+                ASSERT_EQ(ids, expected) << "key='" << key << "'";
+                EXPECT_EQ(set.matchFirst(key), expected.empty() ? PatternSet::npos : expected.front());
+            }
+        }
+    }
+}
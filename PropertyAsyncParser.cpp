@@ -0,0 +1,168 @@
+#include "PropertyAsyncParser.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <utility>
+
+void PropertyTask::promise_type::unhandled_exception() noexcept { std::abort(); }
+
+PropertyEventLoop::PropertyEventLoop() : m_epoll(epoll_create1(EPOLL_CLOEXEC)) {}
+
+PropertyEventLoop::~PropertyEventLoop() {
+    if (m_epoll >= 0) {
+        ::close(m_epoll);
+    }
+}
+
+bool PropertyEventLoop::watchReadable(int fd, Handler handler, void* data) {
+    if (m_epoll < 0) {
+        return false;
+    }
+    const auto found = m_watches.find(fd);
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = fd;
+    // A one-shot registration stays in the epoll set disabled after it fired: re-arm it.
+    if (epoll_ctl(m_epoll, found == m_watches.end() ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) != 0) {
+        return false;
+    }
+    Watch& watch = m_watches[fd];
+    if (!watch.armed) {
+        ++m_pending;
+    }
+    watch = {handler, data, true};
+    return true;
+}
+
+void PropertyEventLoop::forget(int fd) {
+    const auto found = m_watches.find(fd);
+    if (found == m_watches.end()) {
+        return;
+    }
+    if (found->second.armed) {
+        --m_pending;
+    }
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    m_watches.erase(found);
+}
+
+bool PropertyEventLoop::run() {
+    epoll_event events[64];
+    while (m_pending > 0) {
+        const int count = epoll_wait(m_epoll, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            const auto found = m_watches.find(events[i].data.fd);
+            if (found == m_watches.end() || !found->second.armed) {
+                continue;
+            }
+            Watch& watch = found->second;
+            watch.armed = false;
+            --m_pending;
+            // The handler may re-arm or forget the descriptor.
+            watch.handler(watch.data);
+        }
+    }
+    return true;
+}
+
+PropertyAsyncParser::PropertyAsyncParser(PropertyEventLoop& loop, int fd, size_t maxBufferSize, bool caseInsensitive,
+                                         size_t readSize)
+    : m_loop(loop), m_fd(fd), m_parser(maxBufferSize, caseInsensitive), m_chunk(readSize ? readSize : 1) {
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+        m_failed = true;
+        m_done = true;
+    }
+}
+
+PropertyAsyncParser::~PropertyAsyncParser() {
+    if (m_watched) {
+        m_loop.forget(m_fd);
+    }
+}
+
+bool PropertyAsyncParser::takeRecord() {
+    if (!PropertyParserSteps::hasRecord(m_parser)) {
+        return false;
+    }
+    m_record = PropertyParserSteps::currentRecord(m_parser);
+    m_record.offset = 0;
+    m_hasRecord = true;
+    return true;
+}
+
+bool PropertyAsyncParser::step() {
+    m_hasRecord = false;
+    m_record = PropertyRecord{};
+    while (!m_done) {
+        if (m_chunkActive) {
+            // feedAndParse(), one record at a time; the trailing partial record is buffered by the parser.
+            while (PropertyParserSteps::parseFed(m_parser, m_chunk.data(), m_chunkLength, m_position)) {
+                if (takeRecord()) {
+                    return true;
+                }
+            }
+            m_chunkActive = false;
+            continue;
+        }
+
+        if (m_endOfStream) {
+            // finish(), one record at a time
+            while (PropertyParserSteps::finish(m_parser)) {
+                if (takeRecord()) {
+                    return true;
+                }
+            }
+            m_done = true;
+            break;
+        }
+
+        const ssize_t size = ::read(m_fd, m_chunk.data(), m_chunk.size());
+        if (size > 0) {
+            m_chunkLength = static_cast<size_t>(size);
+            m_position = PropertyParserSteps::beginFeed(m_parser, m_chunkLength);
+            m_chunkActive = true;
+        } else if (size == 0) {
+            m_endOfStream = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return false;
+        } else if (errno != EINTR) {
+            m_failed = true;
+            m_done = true;
+        }
+    }
+    return true;
+}
+
+bool PropertyAsyncParser::NextAwaiter::await_suspend(std::coroutine_handle<> waiting) {
+    m_parser.m_waiting = waiting;
+    if (!m_parser.m_loop.watchReadable(m_parser.m_fd, &PropertyAsyncParser::onReadable, &m_parser)) {
+        m_parser.m_failed = true;
+        m_parser.m_done = true;
+        return false;
+    }
+    m_parser.m_watched = true;
+    return true;
+}
+
+void PropertyAsyncParser::onReadable(void* data) {
+    PropertyAsyncParser* parser = static_cast<PropertyAsyncParser*>(data);
+    if (!parser->step() && parser->m_loop.watchReadable(parser->m_fd, &PropertyAsyncParser::onReadable, parser)) {
+        return;
+    }
+    if (!parser->m_hasRecord && !parser->m_done) {
+        // Could not re-arm the watch.
+        parser->m_failed = true;
+        parser->m_done = true;
+    }
+    std::exchange(parser->m_waiting, {}).resume();
+}
@@ -0,0 +1,140 @@
+#ifndef PROPERTY_ASYNC_PARSER_H
+#define PROPERTY_ASYNC_PARSER_H
+
+// C++20 coroutine interface for property streams read from non-blocking descriptors (sockets,
+// pipes). Built only with the CMake option PROP_PARSER_COROUTINES (target prop_parser_async); the
+// event loop uses epoll, so it is Linux only.
+//
+//     PropertyTask consume(PropertyEventLoop& loop, int fd) {
+//         PropertyAsyncParser parser(loop, fd, 4096);
+//         while (co_await parser.next()) {
+//             const PropertyRecord& record = parser.record();
+//         }
+//     }
+//     consume(loop, fd);
+//     loop.run();
+//
+// A parser suspends its coroutine when the bytes at hand end inside a token and resumes it once the
+// descriptor is readable again; the token is then continued where the tokenizer stopped, not
+// rescanned. One loop (and one thread) serves any number of streams; use a loop per thread to
+// spread the streams over a few threads.
+
+#include "PropertyParserSteps.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Detached coroutine started by a call: it runs until its first suspension and frees itself when done.
+struct PropertyTask {
+    struct promise_type {
+        PropertyTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() noexcept;
+    };
+};
+
+// Single-threaded epoll loop resuming the coroutines waiting for readable descriptors.
+class PropertyEventLoop {
+public:
+    typedef void (*Handler)(void*);
+
+    PropertyEventLoop();
+    ~PropertyEventLoop();
+
+    PropertyEventLoop(const PropertyEventLoop&) = delete;
+    PropertyEventLoop& operator=(const PropertyEventLoop&) = delete;
+
+    bool isOpen() const { return m_epoll >= 0; }
+
+    // Call handler(data) once, when fd becomes readable or is closed by the peer. Returns false if
+    // fd cannot be watched.
+    bool watchReadable(int fd, Handler handler, void* data);
+
+    // Stop watching fd (call before closing it).
+    void forget(int fd);
+
+    // Dispatch events until nothing is watched anymore. Returns false on an epoll error.
+    bool run();
+
+    // Number of armed watches.
+    size_t pending() const { return m_pending; }
+
+private:
+    struct Watch {
+        Handler handler;
+        void* data;
+        bool armed;
+    };
+
+    int m_epoll{-1};
+    size_t m_pending{0};
+    std::unordered_map<int, Watch> m_watches;
+};
+
+// Stream parser driven by co_await. Records are the ones feedAndParse() with the chunks read from
+// the descriptor and finish() at the end of the stream would deliver.
+class PropertyAsyncParser {
+public:
+    static constexpr size_t kDefaultReadSize = 64 * 1024;
+
+    // fd is switched to non-blocking mode; it is not closed by the parser.
+    PropertyAsyncParser(PropertyEventLoop& loop, int fd, size_t maxBufferSize, bool caseInsensitive = false,
+                        size_t readSize = kDefaultReadSize);
+    ~PropertyAsyncParser();
+
+    PropertyAsyncParser(const PropertyAsyncParser&) = delete;
+    PropertyAsyncParser& operator=(const PropertyAsyncParser&) = delete;
+
+    class NextAwaiter {
+    public:
+        explicit NextAwaiter(PropertyAsyncParser& parser) : m_parser(parser) {}
+
+        bool await_ready() { return m_parser.step(); }
+        bool await_suspend(std::coroutine_handle<> waiting);
+        bool await_resume() const { return m_parser.m_hasRecord; }
+
+    private:
+        PropertyAsyncParser& m_parser;
+    };
+
+    // co_await next() yields true with the next record in record(), or false at the end of the
+    // stream (or when reading failed, see failed()).
+    NextAwaiter next() { return NextAwaiter(*this); }
+
+    // The current record; its views are valid until next() is awaited again. PropertyRecord::offset
+    // is not tracked in streams (0).
+    const PropertyRecord& record() const { return m_record; }
+
+    bool failed() const { return m_failed; }
+    const PropertyParser& parser() const { return m_parser; }
+
+private:
+    PropertyEventLoop& m_loop;
+    int m_fd;
+    PropertyParser m_parser;
+
+    std::vector<char> m_chunk; // last bytes read, tokenized in place
+    size_t m_chunkLength{0};
+    bool m_chunkActive{false};
+    PropertyParserSteps::FeedPosition m_position;
+
+    PropertyRecord m_record{};
+    bool m_hasRecord{false};
+    bool m_endOfStream{false};
+    bool m_done{false};
+    bool m_failed{false};
+    bool m_watched{false};
+    std::coroutine_handle<> m_waiting;
+
+    // Produce the next record from the bytes at hand, reading more while the descriptor has some.
+    // Returns false if the coroutine has to wait for the descriptor.
+    bool step();
+    bool takeRecord();
+    static void onReadable(void* parser);
+};
+
+#endif // PROPERTY_ASYNC_PARSER_H
@@ -0,0 +1,106 @@
+#include "PropertyAsyncParser.h"
+#include <gtest/gtest.h>
+#include <deque>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct Record {
+    std::string name;
+    std::string value;
+    std::string match;
+    bool valid;
+
+    bool operator==(const Record& other) const = default;
+};
+
+void collect(void* data, const PropertyParser& parser) {
+    static_cast<std::vector<Record>*>(data)->push_back(
+        {parser.getPropertyName(), parser.getPropertyValue(), parser.getPropertyMatch(), parser.isValid()});
+}
+
+std::vector<Record> parseAll(const std::string& input, size_t bufferSize) {
+    std::vector<Record> records;
+    PropertyParser parser(bufferSize);
+    parser.feedAndParse(input.data(), input.size(), collect, &records);
+    parser.finish(collect, &records);
+    return records;
+}
+
+PropertyTask consume(PropertyEventLoop& loop, int fd, size_t bufferSize, std::vector<Record>& records, bool& failed) {
+    PropertyAsyncParser parser(loop, fd, bufferSize, false, 7);
+    while (co_await parser.next()) {
+        const PropertyRecord& record = parser.record();
+        records.push_back({std::string(record.name), std::string(record.value), std::string(record.match), record.valid});
+    }
+    failed = parser.failed();
+}
+
+} // namespace
+
+TEST(PropertyAsyncParserTest, ResumesOnFragmentedInput) {
+    const std::string input = "a = 1\nquoted=\"x;y\"\n# comment\nbad line\r\nlong.value=" + std::string(100, 'v') +
+                              "\ncontinued=one\\\ntwo\nlast=end";
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    PropertyEventLoop loop;
+    ASSERT_TRUE(loop.isOpen());
+    std::vector<Record> records;
+    bool failed = true;
+    consume(loop, fds[0], 256, records, failed);
+    EXPECT_EQ(loop.pending(), 1u); // nothing written yet: suspended
+
+    // The writer sends the input in small fragments, so tokens keep ending mid-way.
+    std::thread writer([&] {
+        for (size_t offset = 0; offset < input.size(); offset += 5) {
+            const size_t length = std::min<size_t>(5, input.size() - offset);
+            ASSERT_EQ(write(fds[1], input.data() + offset, length), static_cast<ssize_t>(length));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        close(fds[1]);
+    });
+    EXPECT_TRUE(loop.run());
+    writer.join();
+    close(fds[0]);
+
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(records, parseAll(input, 256));
+    EXPECT_EQ(records.back().name, "last");
+}
+
+TEST(PropertyAsyncParserTest, ManyStreamsOnOneLoop) {
+    const size_t streams = 200;
+    PropertyEventLoop loop;
+    std::vector<int> readers;
+    std::vector<int> writers;
+    std::vector<std::vector<Record>> records(streams);
+    std::deque<bool> failed(streams, true);
+    for (size_t i = 0; i < streams; ++i) {
+        int fds[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        readers.push_back(fds[0]);
+        writers.push_back(fds[1]);
+        consume(loop, fds[0], 64, records[i], failed[i]);
+    }
+    EXPECT_EQ(loop.pending(), streams);
+
+    for (size_t i = 0; i < streams; ++i) {
+        const std::string input = "stream=" + std::to_string(i) + "\nkey=value\n";
+        ASSERT_EQ(write(writers[i], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+        close(writers[i]);
+    }
+    EXPECT_TRUE(loop.run());
+    EXPECT_EQ(loop.pending(), 0u);
+
+    for (size_t i = 0; i < streams; ++i) {
+        EXPECT_FALSE(failed[i]);
+        ASSERT_EQ(records[i].size(), 2u);
+        EXPECT_EQ(records[i][0].value, std::to_string(i));
+        close(readers[i]);
+    }
+}
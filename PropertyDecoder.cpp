@@ -0,0 +1,194 @@
+#include "PropertyDecoder.h"
+
+#include "AsciiCase.h"
+#include "PropertyParser.h"
+
+#include <charconv>
+#include <cstring>
+#include <system_error>
+
+namespace {
+
+// from_chars() does not take a leading '+'.
+inline const char* skipPlus(const char* begin, const char* end) {
+    return (end - begin > 1 && *begin == '+' && begin[1] != '-') ? begin + 1 : begin;
+}
+
+template <class T>
+PropertyDecoder::Error fromChars(std::string_view value, T& out) {
+    const char* begin = skipPlus(value.data(), value.data() + value.size());
+    const char* end = value.data() + value.size();
+    const std::from_chars_result result = std::from_chars(begin, end, out);
+    if (result.ec == std::errc::result_out_of_range) {
+        return PropertyDecoder::Error::OutOfRange;
+    }
+    if (result.ec != std::errc() || result.ptr != end) {
+        return PropertyDecoder::Error::Syntax;
+    }
+    return PropertyDecoder::Error::None;
+}
+
+bool parseBool(std::string_view value, bool& out) {
+    static const char* const kTrue[] = {"true", "yes", "on", "1"};
+    static const char* const kFalse[] = {"false", "no", "off", "0"};
+    for (const char* word : kTrue) {
+        if (equalsFolded(value, word)) {
+            out = true;
+            return true;
+        }
+    }
+    for (const char* word : kFalse) {
+        if (equalsFolded(value, word)) {
+            out = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+PropertyDecoder::PropertyDecoder(bool caseInsensitive) : m_caseInsensitive(caseInsensitive) {}
+
+uint64_t PropertyDecoder::hashKey(std::string_view key, uint64_t seed) const {
+    // Mixed so that the low bits (the slot) depend on all bytes
+    const uint64_t hash = hashFolded(key, m_caseInsensitive, kFnv1aBasis ^ (seed * 0x9E3779B97F4A7C15ull));
+    return hash ^ (hash >> 29);
+}
+
+bool PropertyDecoder::sameKey(std::string_view stored, std::string_view key) const {
+    return m_caseInsensitive ? equalsFolded(stored, key) : stored == key;
+}
+
+size_t PropertyDecoder::add(std::string_view key, Type type, size_t offset) {
+    if (key.empty() || find(key) != npos) {
+        return npos;
+    }
+    Field field{std::string(key), type, offset, {}};
+    if (m_caseInsensitive) {
+        foldAsciiCopy(field.key.data(), field.key.size(), &field.key[0]);
+    }
+    m_fields.push_back(std::move(field));
+    buildHash();
+    return m_fields.size() - 1;
+}
+
+size_t PropertyDecoder::addEnum(std::string_view key, size_t offset, std::vector<std::pair<std::string, int>> names) {
+    const size_t field = add(key, Type::Enum, offset);
+    if (field != npos) {
+        m_fields[field].enumNames = std::move(names);
+    }
+    return field;
+}
+
+void PropertyDecoder::buildHash() {
+    // At most half of the slots are used, so a collision-free seed is found after a few tries;
+    // the table doubles if it is not.
+    size_t slotCount = 2;
+    while (slotCount < m_fields.size() * 2) {
+        slotCount *= 2;
+    }
+    for (;; slotCount *= 2) {
+        for (uint64_t seed = 0; seed < 64; ++seed) {
+            m_slots.assign(slotCount, 0);
+            bool collision = false;
+            for (size_t i = 0; i < m_fields.size() && !collision; ++i) {
+                uint32_t& slot = m_slots[hashKey(m_fields[i].key, seed) & (slotCount - 1)];
+                collision = slot != 0;
+                slot = static_cast<uint32_t>(i + 1);
+            }
+            if (!collision) {
+                m_seed = seed;
+                return;
+            }
+        }
+    }
+}
+
+size_t PropertyDecoder::find(std::string_view key) const {
+    if (m_slots.empty()) {
+        return npos;
+    }
+    const uint32_t slot = m_slots[hashKey(key, m_seed) & (m_slots.size() - 1)];
+    if (slot == 0 || !sameKey(m_fields[slot - 1].key, key)) {
+        return npos;
+    }
+    return slot - 1;
+}
+
+PropertyDecoder::Error PropertyDecoder::decode(void* object, size_t field, std::string_view value) const {
+    const Field& f = m_fields[field];
+    char* destination = static_cast<char*>(object) + f.offset;
+    switch (f.type) {
+    case Type::Int64: {
+        int64_t number;
+        const Error error = fromChars(value, number);
+        if (error == Error::None) {
+            std::memcpy(destination, &number, sizeof(number));
+        }
+        return error;
+    }
+    case Type::Double: {
+        double number;
+        const Error error = fromChars(value, number);
+        if (error == Error::None) {
+            std::memcpy(destination, &number, sizeof(number));
+        }
+        return error;
+    }
+    case Type::Bool: {
+        bool flag;
+        if (!parseBool(value, flag)) {
+            return Error::Syntax;
+        }
+        std::memcpy(destination, &flag, sizeof(flag));
+        return Error::None;
+    }
+    case Type::String:
+        reinterpret_cast<std::string*>(destination)->assign(value.data(), value.size());
+        return Error::None;
+    case Type::Enum:
+        for (const auto& name : f.enumNames) {
+            if (sameKey(name.first, value)) {
+                std::memcpy(destination, &name.second, sizeof(name.second));
+                return Error::None;
+            }
+        }
+        return Error::Syntax;
+    }
+    return Error::Syntax;
+}
+
+PropertyDecoder::Target::Target(const PropertyDecoder& decoder, void* object)
+    : m_decoder(decoder), m_object(object), m_seen(decoder.size(), false), m_errors(decoder.size(), Error::None) {}
+
+void PropertyDecoder::Target::decode(std::string_view name, std::string_view value) {
+    const size_t field = m_decoder.find(name);
+    if (field == npos) {
+        ++m_unknownKeys;
+        return;
+    }
+    if (m_seen[field]) {
+        return;
+    }
+    m_seen[field] = true;
+    m_errors[field] = m_decoder.decode(m_object, field, value);
+    if (m_errors[field] != Error::None) {
+        m_failed.push_back(field);
+    }
+}
+
+void PropertyDecoder::Target::callback(void* target, const PropertyParser& parser) {
+    if (parser.isValid()) {
+        static_cast<Target*>(target)->decode(parser.getPropertyNameView(), parser.getPropertyValueView());
+    }
+}
+
+void PropertyDecoder::Target::batchCallback(void* target, const PropertyRecord* records, size_t count) {
+    Target* self = static_cast<Target*>(target);
+    for (size_t i = 0; i < count; ++i) {
+        if (records[i].valid) {
+            self->decode(records[i].name, records[i].value);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef PROPERTY_DECODER_H
+#define PROPERTY_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class PropertyParser;
+struct PropertyRecord;
+
+// Schema-driven decoding of property values straight into the fields of a struct.
+// Every expected key is registered with its type and the offset of the destination field
+// (offsetof(Config, field); the struct must be standard-layout). Values are converted in place from
+// the parser views with std::from_chars, so decoding allocates nothing except for string fields.
+// Keys are recognized through a perfect hash rebuilt on every add(): a lookup hashes the name once
+// and compares it with a single candidate. Errors are reported per field, never thrown.
+// Like findPropertyValue(), the first occurrence of a key is decoded and later ones are ignored.
+class PropertyDecoder {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    enum class Type {
+        Int64,  // int64_t field
+        Double, // double field
+        Bool,   // bool field: true/false, yes/no, on/off, 1/0 (any case)
+        String, // std::string field
+        Enum,   // int field, set to the value of one of the registered names
+    };
+
+    enum class Error {
+        None,
+        Syntax,      // the value is not a number / boolean / enum name
+        OutOfRange,  // the number does not fit into the field
+    };
+
+    // In case-insensitive mode keys and enum names match in any case.
+    explicit PropertyDecoder(bool caseInsensitive = false);
+
+    // Register a key. Returns the field index (in registration order), or npos if the key is
+    // already registered or empty.
+    size_t add(std::string_view key, Type type, size_t offset);
+    size_t addEnum(std::string_view key, size_t offset, std::vector<std::pair<std::string, int>> names);
+
+    size_t size() const { return m_fields.size(); }
+    std::string_view key(size_t field) const { return m_fields[field].key; }
+    bool isCaseInsensitive() const { return m_caseInsensitive; }
+
+    // Field index of a key, or npos.
+    size_t find(std::string_view key) const;
+
+    // Convert value and store it into the field of object; the field is left unchanged on error.
+    Error decode(void* object, size_t field, std::string_view value) const;
+
+    // Decoding state for one destination object. Its callbacks can be passed straight to the parser:
+    //     PropertyDecoder::Target target(decoder, &config);
+    //     parser.feedAndParse(data, length, PropertyDecoder::Target::callback, &target);
+    class Target {
+    public:
+        Target(const PropertyDecoder& decoder, void* object);
+
+        // Decode one property. Unknown keys are counted and otherwise ignored.
+        void decode(std::string_view name, std::string_view value);
+
+        static void callback(void* target, const PropertyParser& parser);
+        static void batchCallback(void* target, const PropertyRecord* records, size_t count);
+
+        // Whether the key of field was seen (decoded or not).
+        bool isSet(size_t field) const { return m_seen[field]; }
+        Error error(size_t field) const { return m_errors[field]; }
+
+        // Fields whose value could not be decoded, in the order the errors occurred.
+        const std::vector<size_t>& failedFields() const { return m_failed; }
+        bool hasErrors() const { return !m_failed.empty(); }
+
+        size_t unknownKeys() const { return m_unknownKeys; }
+
+    private:
+        const PropertyDecoder& m_decoder;
+        void* m_object;
+        std::vector<bool> m_seen;
+        std::vector<Error> m_errors;
+        std::vector<size_t> m_failed;
+        size_t m_unknownKeys{0};
+    };
+
+private:
+    struct Field {
+        std::string key; // folded in case-insensitive mode
+        Type type;
+        size_t offset;
+        std::vector<std::pair<std::string, int>> enumNames;
+    };
+
+    bool m_caseInsensitive;
+    std::vector<Field> m_fields;
+
+    // Perfect hash: slot (hash(key, m_seed) & (m_slots.size() - 1)) holds field index + 1.
+    uint64_t m_seed{0};
+    std::vector<uint32_t> m_slots;
+
+    uint64_t hashKey(std::string_view key, uint64_t seed) const;
+    bool sameKey(std::string_view stored, std::string_view key) const;
+    void buildHash();
+};
+
+#endif // PROPERTY_DECODER_H
@@ -0,0 +1,108 @@
+#include "PropertyDecoder.h"
+#include "PropertyParser.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+
+namespace {
+
+enum Level { kLow, kHigh };
+
+struct Config {
+    int64_t timeout{0};
+    double ratio{0};
+    bool enabled{false};
+    std::string name;
+    int level{kLow};
+};
+
+PropertyDecoder makeDecoder(bool caseInsensitive = false) {
+    PropertyDecoder decoder(caseInsensitive);
+    decoder.add("timeout", PropertyDecoder::Type::Int64, offsetof(Config, timeout));
+    decoder.add("ratio", PropertyDecoder::Type::Double, offsetof(Config, ratio));
+    decoder.add("enabled", PropertyDecoder::Type::Bool, offsetof(Config, enabled));
+    decoder.add("name", PropertyDecoder::Type::String, offsetof(Config, name));
+    decoder.addEnum("level", offsetof(Config, level), {{"low", kLow}, {"high", kHigh}});
+    return decoder;
+}
+
+} // namespace
+
+TEST(PropertyDecoderTest, DecodesIntoStruct) {
+    const PropertyDecoder decoder = makeDecoder();
+    EXPECT_EQ(decoder.size(), 5u);
+    EXPECT_EQ(decoder.find("enabled"), 2u);
+    EXPECT_EQ(decoder.find("Enabled"), PropertyDecoder::npos);
+
+    Config config;
+    PropertyDecoder::Target target(decoder, &config);
+    const std::string input = "timeout = 250\nratio=-1.5e2\nenabled=Yes\nname=\"a b\"\nlevel=high\nother=1\ntimeout=7\n";
+    PropertyParser parser(64);
+    parser.feedAndParse(input.data(), input.size(), PropertyDecoder::Target::callback, &target);
+    parser.finish(PropertyDecoder::Target::callback, &target);
+
+    EXPECT_EQ(config.timeout, 250); // first occurrence wins
+    EXPECT_DOUBLE_EQ(config.ratio, -150.0);
+    EXPECT_TRUE(config.enabled);
+    EXPECT_EQ(config.name, "a b");
+    EXPECT_EQ(config.level, kHigh);
+    EXPECT_FALSE(target.hasErrors());
+    EXPECT_EQ(target.unknownKeys(), 1u);
+    for (size_t i = 0; i < decoder.size(); ++i) {
+        EXPECT_TRUE(target.isSet(i));
+    }
+}
+
+TEST(PropertyDecoderTest, ReportsErrorsPerField) {
+    const PropertyDecoder decoder = makeDecoder();
+    Config config;
+    config.timeout = 5;
+    PropertyDecoder::Target target(decoder, &config);
+    target.decode("timeout", "99999999999999999999");
+    target.decode("ratio", "1.5x");
+    target.decode("enabled", "maybe");
+    target.decode("level", "HIGH");
+
+    EXPECT_EQ(target.error(decoder.find("timeout")), PropertyDecoder::Error::OutOfRange);
+    EXPECT_EQ(target.error(decoder.find("ratio")), PropertyDecoder::Error::Syntax);
+    EXPECT_EQ(target.error(decoder.find("enabled")), PropertyDecoder::Error::Syntax);
+    EXPECT_EQ(target.error(decoder.find("level")), PropertyDecoder::Error::Syntax);
+    EXPECT_EQ(target.failedFields().size(), 4u);
+    EXPECT_FALSE(target.isSet(decoder.find("name")));
+    EXPECT_EQ(config.timeout, 5); // unchanged on error
+
+    EXPECT_EQ(decoder.decode(&config, decoder.find("timeout"), "+12"), PropertyDecoder::Error::None);
+    EXPECT_EQ(config.timeout, 12);
+    EXPECT_EQ(decoder.decode(&config, decoder.find("timeout"), ""), PropertyDecoder::Error::Syntax);
+}
+
+TEST(PropertyDecoderTest, CaseInsensitiveAndBatch) {
+    const PropertyDecoder decoder = makeDecoder(true);
+    PropertyDecoder probe;
+    EXPECT_EQ(probe.add("x", PropertyDecoder::Type::Int64, 0), 0u);
+    EXPECT_EQ(probe.add("x", PropertyDecoder::Type::Int64, 0), PropertyDecoder::npos);
+
+    Config config;
+    PropertyDecoder::Target target(decoder, &config);
+    const std::string input = "TimeOut=1\nLEVEL=High\nEnabled=off\n";
+    PropertyParser parser(64, true);
+    parser.feedAndParseBatch(input.data(), input.size(), PropertyDecoder::Target::batchCallback, &target);
+
+    EXPECT_EQ(config.timeout, 1);
+    EXPECT_EQ(config.level, kHigh);
+    EXPECT_FALSE(config.enabled);
+    EXPECT_FALSE(target.hasErrors());
+    EXPECT_FALSE(target.isSet(decoder.find("NAME")));
+}
+
+TEST(PropertyDecoderTest, PerfectHashManyKeys) {
+    PropertyDecoder decoder;
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(decoder.add("key." + std::to_string(i), PropertyDecoder::Type::Int64, 0), static_cast<size_t>(i));
+    }
+    for (int i = 0; i < 300; ++i) {
+        EXPECT_EQ(decoder.find("key." + std::to_string(i)), static_cast<size_t>(i));
+    }
+    EXPECT_EQ(decoder.find("key.300"), PropertyDecoder::npos);
+    EXPECT_EQ(decoder.key(42), "key.42");
+}
@@ -0,0 +1,200 @@
+#include "PropertyDiff.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// The tokenizer looks at most two bytes past the byte it is at, so a step that ends this far
+// before the first changed byte did not see it.
+const size_t kLookahead = 8;
+
+} // namespace
+
+PropertyDiff::PropertyDiff(size_t maxBufferSize, bool caseInsensitive)
+    : m_names(caseInsensitive), m_parser(maxBufferSize, caseInsensitive) {
+    m_parser.setNameTable(&m_names);
+}
+
+void PropertyDiff::clear() {
+    m_text.clear();
+    m_steps.clear();
+    m_first.clear();
+    m_size = 0;
+    m_reparsedBytes = 0;
+}
+
+bool PropertyDiff::find(std::string_view name, std::string_view& value) const {
+    value = {};
+    const uint32_t id = m_names.find(name);
+    if (id == PropertyNameTable::npos || id >= m_first.size() || m_first[id] == npos) {
+        return false;
+    }
+    value = m_steps[m_first[id]].value;
+    return true;
+}
+
+size_t PropertyDiff::restartStep(size_t prefix, size_t length) const {
+    // The last step that starts well inside the common prefix...
+    size_t step = static_cast<size_t>(
+        std::upper_bound(m_steps.begin(), m_steps.end(), prefix,
+                         [](size_t position, const Step& s) { return position < s.begin + kLookahead; }) -
+        m_steps.begin());
+    if (step == 0) {
+        return 0;
+    }
+    --step;
+    // ...whose fill is not cut by the end of either version, so that the new parse reaches it in the same state.
+    while (step > 0 && (m_steps[step].fillEnd >= m_text.size() || m_steps[step].fillEnd > length)) {
+        --step;
+    }
+    return step;
+}
+
+void PropertyDiff::update(const char* data, size_t length, PropertyDiffCallback callback, void* callbackData) {
+    const size_t oldLength = m_text.size();
+    const size_t common = std::min(oldLength, length);
+    const size_t prefix = static_cast<size_t>(std::mismatch(data, data + common, m_text.data()).first - data);
+    size_t suffix = 0;
+    while (suffix < common - prefix && data[length - 1 - suffix] == m_text[oldLength - 1 - suffix]) {
+        ++suffix;
+    }
+
+    m_reparsedBytes = 0;
+    if (prefix == length && length == oldLength && !m_steps.empty()) {
+        return;
+    }
+
+    // Re-tokenize from a step before the change; in the common suffix, take over the steps of the
+    // previous version as the parallel stitch does (PropertyParser::parseParallel()).
+    const size_t first = restartStep(prefix, length);
+    PropertyParserSteps::FeedPosition position;
+    if (first < m_steps.size() && first > 0) {
+        position.processed = m_steps[first].begin;
+        position.fillEnd = m_steps[first].fillEnd;
+    }
+
+    auto shift = [&](size_t oldPosition) { return oldPosition - oldLength + length; };
+    m_fresh.clear();
+    m_plan.clear();
+    m_parser.reset();
+    size_t cursor = first;
+    while (position.processed < length) {
+        PropertyParserSteps::refill(m_parser, position, length);
+
+        if (position.processed >= length - suffix) {
+            const size_t oldBegin = position.processed - length + oldLength;
+            while (cursor < m_steps.size() && m_steps[cursor].begin < oldBegin) {
+                ++cursor;
+            }
+            const size_t fillEnd = position.fillEnd;
+            if (cursor < m_steps.size() && m_steps[cursor].begin == oldBegin &&
+                PropertyParserSteps::reuseStep(m_parser, m_steps[cursor], length - oldLength, data, length, position)) {
+                m_plan.push_back({true, cursor, fillEnd, position.fillEnd});
+                ++cursor;
+                continue;
+            }
+        }
+
+        Step step{{position.processed, position.fillEnd, length, 0}, PropertyNameTable::npos, {}};
+        const bool parsed = PropertyParserSteps::parseComplete(m_parser, data, length, position);
+        if (parsed) {
+            step.end = position.processed;
+            step.nextFillEnd = position.fillEnd;
+            if (m_parser.isValid()) {
+                step.nameId = m_parser.getPropertyNameId();
+                step.value.assign(m_parser.getPropertyValueView());
+            }
+        }
+        m_reparsedBytes += step.end - step.begin;
+        m_plan.push_back({false, m_fresh.size(), 0, 0});
+        m_fresh.push_back(std::move(step));
+        PropertyParserSteps::clearResult(m_parser);
+        if (!parsed) {
+            break;
+        }
+    }
+    m_parser.reset();
+
+    // Names whose records were dropped or added, in record order, with their values before the update.
+    m_affected.assign(m_names.size(), false);
+    std::vector<uint32_t> affected;
+    std::vector<std::string> oldValues;
+    std::vector<bool> existed;
+    auto affect = [&](uint32_t id) {
+        if (id == PropertyNameTable::npos || m_affected[id]) {
+            return;
+        }
+        m_affected[id] = true;
+        affected.push_back(id);
+        const bool exists = id < m_first.size() && m_first[id] != npos;
+        existed.push_back(exists);
+        oldValues.push_back(exists ? m_steps[m_first[id]].value : std::string());
+    };
+    size_t reused = first;
+    for (const PlanItem& item : m_plan) {
+        if (!item.reused) {
+            continue;
+        }
+        for (; reused < item.index; ++reused) {
+            affect(m_steps[reused].nameId);
+        }
+        ++reused;
+    }
+    for (; reused < m_steps.size(); ++reused) {
+        affect(m_steps[reused].nameId);
+    }
+    for (const Step& step : m_fresh) {
+        affect(step.nameId);
+    }
+
+    // Steps of the new version: the prefix steps as they are, then the plan.
+    std::vector<Step> steps;
+    steps.reserve(first + m_plan.size());
+    std::move(m_steps.begin(), m_steps.begin() + std::min(first, m_steps.size()), std::back_inserter(steps));
+    for (const PlanItem& item : m_plan) {
+        if (item.reused) {
+            Step& step = m_steps[item.index];
+            step.begin = shift(step.begin);
+            step.end = shift(step.end);
+            step.fillEnd = item.fillEnd;
+            step.nextFillEnd = item.nextFillEnd;
+            steps.push_back(std::move(step));
+        } else {
+            steps.push_back(std::move(m_fresh[item.index]));
+        }
+    }
+    m_steps.swap(steps);
+    m_text.assign(data, length);
+    indexFirstOccurrences();
+
+    if (!callback) {
+        return;
+    }
+    for (size_t i = 0; i < affected.size(); ++i) {
+        const uint32_t id = affected[i];
+        const bool exists = m_first[id] != npos;
+        const std::string_view value = exists ? std::string_view(m_steps[m_first[id]].value) : std::string_view();
+        PropertyChange change{PropertyChange::Modified, m_names.name(id), oldValues[i], value, id};
+        if (!existed[i] && exists) {
+            change.kind = PropertyChange::Added;
+        } else if (existed[i] && !exists) {
+            change.kind = PropertyChange::Removed;
+        } else if (!exists || oldValues[i] == value) {
+            continue;
+        }
+        callback(callbackData, change);
+    }
+}
+
+void PropertyDiff::indexFirstOccurrences() {
+    m_first.assign(m_names.size(), npos);
+    m_size = 0;
+    for (size_t i = 0; i < m_steps.size(); ++i) {
+        const uint32_t id = m_steps[i].nameId;
+        if (id != PropertyNameTable::npos && m_first[id] == npos) {
+            m_first[id] = i;
+            ++m_size;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef PROPERTY_DIFF_H
+#define PROPERTY_DIFF_H
+
+#include "PropertyNameTable.h"
+#include "PropertyParserSteps.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One property that differs between two versions of an input.
+struct PropertyChange {
+    enum Kind { Added, Removed, Modified };
+
+    Kind kind;
+    std::string_view name;
+    std::string_view oldValue; // empty for Added
+    std::string_view newValue; // empty for Removed
+    uint32_t nameId;           // ID of name in PropertyDiff::names()
+};
+
+// Change callback type: takes a void pointer and one change; the views are valid until it returns.
+typedef void (*PropertyDiffCallback)(void*, const PropertyChange& change);
+
+// Differential reparse of an input that is replaced by new versions (a reloaded config file).
+// update() reports only the properties that were added, removed or modified since the previous
+// version. The properties are the valid records of PropertyParser(maxBufferSize, caseInsensitive) fed
+// the whole input and finished; the first occurrence of a name wins, like in findPropertyValue().
+// Only the bytes between the common prefix and the common suffix of the two versions are tokenized
+// again: the parse restarts at a record boundary before the change and stops following the new
+// bytes once it is back at a record boundary of the previous version (with the same tokenizer state)
+// inside the common suffix. The rest of an update is linear but cheap: comparing the versions,
+// copying the new one and shifting the positions of the records after the change.
+class PropertyDiff {
+public:
+    explicit PropertyDiff(size_t maxBufferSize, bool caseInsensitive = false);
+
+    PropertyDiff(const PropertyDiff&) = delete;
+    PropertyDiff& operator=(const PropertyDiff&) = delete;
+
+    // Make data (which is copied) the current version and report the changes; the first update
+    // reports every property as Added. Changes come in record order, names of dropped records
+    // first, then those of new records.
+    void update(const char* data, size_t length, PropertyDiffCallback callback = nullptr, void* callbackData = nullptr);
+
+    // Forget the current version; the next update() reports everything as Added.
+    void clear();
+
+    // Current value of a property. In case-insensitive mode name may use any case.
+    bool find(std::string_view name, std::string_view& value) const;
+
+    // Number of distinct properties in the current version.
+    size_t size() const { return m_size; }
+
+    // Every name seen so far, with the IDs reported in PropertyChange::nameId.
+    const PropertyNameTable& names() const { return m_names; }
+
+    // Bytes tokenized by the last update() (the whole input for the first one).
+    size_t lastReparsedBytes() const { return m_reparsedBytes; }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // One parsing step (see PropertyParserSteps::StepSpan) and the property it produced, if any.
+    struct Step : PropertyParserSteps::StepSpan {
+        uint32_t nameId; // PropertyNameTable::npos if the step produced no valid property
+        std::string value;
+    };
+
+    // Step of the new version: a step of the previous one moved by the length difference (with the
+    // fill of the new parse), or a newly tokenized one.
+    struct PlanItem {
+        bool reused;
+        size_t index; // in m_steps if reused, in m_fresh otherwise
+        size_t fillEnd;
+        size_t nextFillEnd;
+    };
+
+    PropertyNameTable m_names;
+    PropertyParser m_parser;
+    std::string m_text;
+    std::vector<Step> m_steps;
+    std::vector<size_t> m_first; // by name ID: index of the step with the first occurrence, or npos
+    size_t m_size{0};
+    size_t m_reparsedBytes{0};
+
+    // Scratch storage of update()
+    std::vector<Step> m_fresh;
+    std::vector<PlanItem> m_plan;
+    std::vector<bool> m_affected;
+
+    size_t restartStep(size_t prefix, size_t length) const;
+    void indexFirstOccurrences();
+};
+
+#endif // PROPERTY_DIFF_H
@@ -0,0 +1,123 @@
+#include "PropertyDiff.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Changes {
+    std::vector<std::string> log;
+};
+
+void logChange(void* data, const PropertyChange& change) {
+    static const char* const kinds[] = {"+", "-", "~"};
+    static_cast<Changes*>(data)->log.push_back(std::string(kinds[change.kind]) + std::string(change.name) + ":" +
+                                               std::string(change.oldValue) + ">" + std::string(change.newValue));
+}
+
+std::map<std::string, std::string> parseAll(const std::string& input, size_t bufferSize) {
+    std::map<std::string, std::string> properties;
+    PropertyParser parser(bufferSize);
+    auto collect = [](void* data, const PropertyParser& p) {
+        if (p.isValid()) {
+            static_cast<std::map<std::string, std::string>*>(data)->emplace(p.getPropertyName(), p.getPropertyValue());
+        }
+    };
+    parser.feedAndParse(input.data(), input.size(), collect, &properties);
+    parser.finish(collect, &properties);
+    return properties;
+}
+
+} // namespace
+
+TEST(PropertyDiffTest, ReportsChanges) {
+    PropertyDiff diff(64);
+    Changes changes;
+    const std::string v1 = "a=1\nb=2\nc=3\n";
+    diff.update(v1.data(), v1.size(), logChange, &changes);
+    EXPECT_EQ(changes.log, (std::vector<std::string>{"+a:>1", "+b:>2", "+c:>3"}));
+    EXPECT_EQ(diff.size(), 3u);
+
+    changes.log.clear();
+    const std::string v2 = "a=1\nb=20\nd=4\n";
+    diff.update(v2.data(), v2.size(), logChange, &changes);
+    EXPECT_EQ(changes.log, (std::vector<std::string>{"~b:2>20", "-c:3>", "+d:>4"}));
+
+    std::string_view value;
+    ASSERT_TRUE(diff.find("b", value));
+    EXPECT_EQ(value, "20");
+    EXPECT_FALSE(diff.find("c", value));
+
+    // Unchanged input: nothing to report, nothing reparsed.
+    changes.log.clear();
+    diff.update(v2.data(), v2.size(), logChange, &changes);
+    EXPECT_TRUE(changes.log.empty());
+    EXPECT_EQ(diff.lastReparsedBytes(), 0u);
+
+    // The first occurrence wins: a new earlier duplicate changes the value, a later one does not.
+    changes.log.clear();
+    const std::string v3 = "d=0\na=1\nb=20\nd=4\nb=5\n";
+    diff.update(v3.data(), v3.size(), logChange, &changes);
+    EXPECT_EQ(changes.log, (std::vector<std::string>{"~d:4>0"}));
+
+    diff.clear();
+    changes.log.clear();
+    diff.update(v1.data(), 4, logChange, &changes);
+    EXPECT_EQ(changes.log, (std::vector<std::string>{"+a:>1"}));
+}
+
+TEST(PropertyDiffTest, ReparsesOnlyTheChange) {
+    std::string input;
+    for (int i = 0; i < 10000; ++i) {
+        input += "key" + std::to_string(i) + " = value" + std::to_string(i) + "\n";
+    }
+    PropertyDiff diff(4096);
+    diff.update(input.data(), input.size());
+    EXPECT_EQ(diff.lastReparsedBytes(), input.size());
+    EXPECT_EQ(diff.size(), 10000u);
+
+    const size_t line = input.find("key5000 ");
+    input.replace(input.find("value5000", line), 9, "changed");
+    Changes changes;
+    diff.update(input.data(), input.size(), logChange, &changes);
+    EXPECT_EQ(changes.log, (std::vector<std::string>{"~key5000:value5000>changed"}));
+    EXPECT_LT(diff.lastReparsedBytes(), 100u);
+
+    std::string_view value;
+    ASSERT_TRUE(diff.find("key9999", value));
+    EXPECT_EQ(value, "value9999");
+}
+
+TEST(PropertyDiffTest, MatchesFullParse) {
+    const char alphabet[] = "ab=  \n\n;\"\\#/*";
+    std::mt19937 rng(7);
+    for (int round = 0; round < 300; ++round) {
+        const size_t bufferSize = 1 + rng() % 40;
+        PropertyDiff diff(bufferSize);
+        std::map<std::string, std::string> shadow;
+        auto apply = [](void* data, const PropertyChange& change) {
+            auto& properties = *static_cast<std::map<std::string, std::string>*>(data);
+            if (change.kind == PropertyChange::Removed) {
+                properties.erase(std::string(change.name));
+            } else {
+                properties[std::string(change.name)] = std::string(change.newValue);
+            }
+        };
+        std::string input;
+        for (int version = 0; version < 10; ++version) {
+            const size_t position = input.empty() ? 0 : rng() % input.size();
+            const size_t removed = std::min<size_t>(rng() % 8, input.size() - position);
+            std::string inserted(rng() % 12, ' ');
+            for (char& c : inserted) {
+                c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+            input.replace(position, removed, inserted);
+
+            diff.update(input.data(), input.size(), apply, &shadow);
+            ASSERT_EQ(shadow, parseAll(input, bufferSize)) << input;
+            ASSERT_EQ(diff.size(), shadow.size());
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include "PropertyIndex.h"
+
+#include "AsciiCase.h"
+#include "PropertyRawScanner.h"
+
+PropertyIndex::PropertyIndex(const char* data, size_t length, bool caseSensitive) { build(data, length, caseSensitive); }
+
+bool PropertyIndex::sameName(const Entry& entry, std::string_view name) const {
+    if (entry.nameLength != name.size()) {
+        return false;
+    }
+    const char* stored = m_names.data() + entry.nameOffset;
+    if (m_caseSensitive) {
+        return name.compare(0, name.size(), stored, entry.nameLength) == 0;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (stored[i] != foldAscii(name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PropertyIndex::build(const char* data, size_t length, bool caseSensitive) {
+    m_data = data;
+    m_caseSensitive = caseSensitive;
+    m_names.clear();
+    m_entries.clear();
+    m_slots.clear();
+
+    PropertyRawScanner scanner(data, length);
+    while (scanner.next()) {
+        const std::string& name = scanner.name();
+        const uint64_t hash = hashFolded(name, !caseSensitive);
+        const size_t slot =
+            m_slots.probe(hash, [&](uint32_t index) { return m_entries[index].hash == hash && sameName(m_entries[index], name); });
+        if (m_slots.at(slot) != 0) {
+            continue; // the first occurrence wins
+        }
+
+        Entry entry{hash, m_names.size(), name.size(), static_cast<size_t>(scanner.valueBegin() - data)};
+        for (const char c : name) {
+            m_names.push_back(caseSensitive ? c : foldAscii(c));
+        }
+        m_entries.push_back(entry);
+        m_slots.insert(slot, [&](size_t index) { return m_entries[index].hash; });
+    }
+}
+
+bool PropertyIndex::find(std::string_view name, const char*& valueBegin) const {
+    valueBegin = nullptr;
+    const uint64_t hash = hashFolded(name, !m_caseSensitive);
+    const uint32_t found =
+        m_slots.at(m_slots.probe(hash, [&](uint32_t index) { return m_entries[index].hash == hash && sameName(m_entries[index], name); }));
+    if (found == 0) {
+        return false;
+    }
+    valueBegin = m_data + m_entries[found - 1].valueOffset;
+    return true;
+}
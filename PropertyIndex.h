@@ -0,0 +1,55 @@
+#ifndef PROPERTY_INDEX_H
+#define PROPERTY_INDEX_H
+
+#include "HashSlots.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Name -> value lookup table over a complete raw buffer, built in a single pass.
+// find() gives the same answer as PropertyParser::findPropertyValue() with the same buffer and
+// case mode (the first property with a given name wins), in constant time and without allocating.
+// The buffer is not copied and must outlive the index.
+class PropertyIndex {
+public:
+    PropertyIndex() = default;
+    PropertyIndex(const char* data, size_t length, bool caseSensitive = true);
+
+    // Index another buffer, dropping the previous contents.
+    void build(const char* data, size_t length, bool caseSensitive = true);
+
+    // Set valueBegin to the first character of the value of name in the buffer.
+    // Returns false (and sets valueBegin to nullptr) if there is no such property.
+    bool find(std::string_view name, const char*& valueBegin) const;
+
+    bool contains(std::string_view name) const {
+        const char* valueBegin;
+        return find(name, valueBegin);
+    }
+
+    // Number of distinct names
+    size_t size() const { return m_entries.size(); }
+    bool isCaseSensitive() const { return m_caseSensitive; }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        size_t nameOffset; // in m_names, folded in case-insensitive mode
+        size_t nameLength;
+        size_t valueOffset; // in the indexed buffer
+    };
+
+    const char* m_data{nullptr};
+    bool m_caseSensitive{true};
+
+    std::string m_names;          // all names back to back
+    std::vector<Entry> m_entries; // in buffer order
+    HashSlots m_slots;
+
+    bool sameName(const Entry& entry, std::string_view name) const;
+};
+
+#endif // PROPERTY_INDEX_H
@@ -0,0 +1,72 @@
+#include "PropertyIndex.h"
+#include "PropertyParser.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <string>
+
+TEST(PropertyIndexTest, FindValues) {
+    const char* src = "a=1\nb = 2;c=\"x;y\"\r\n# d=4\nb=5\n";
+    PropertyIndex index(src, std::strlen(src));
+    EXPECT_EQ(index.size(), 3u);
+
+    const char* valueBegin = nullptr;
+    ASSERT_TRUE(index.find("a", valueBegin));
+    EXPECT_EQ(valueBegin, src + 2);
+    ASSERT_TRUE(index.find("b", valueBegin));
+    EXPECT_EQ(std::string(valueBegin, 1), "2"); // first occurrence wins
+    ASSERT_TRUE(index.find("c", valueBegin));
+    EXPECT_EQ(std::string(valueBegin, 5), "\"x;y\"");
+
+    EXPECT_FALSE(index.find("d", valueBegin));
+    EXPECT_EQ(valueBegin, nullptr);
+    EXPECT_FALSE(index.contains("missing"));
+}
+
+TEST(PropertyIndexTest, CaseInsensitive) {
+    const char* src = "Name=Value\nNAME=Other\n";
+    PropertyIndex index(src, std::strlen(src), false);
+    EXPECT_EQ(index.size(), 1u);
+
+    const char* valueBegin = nullptr;
+    ASSERT_TRUE(index.find("nAmE", valueBegin));
+    EXPECT_EQ(std::string(valueBegin, 5), "Value");
+
+    index.build(src, std::strlen(src), true);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_FALSE(index.contains("name"));
+    ASSERT_TRUE(index.find("NAME", valueBegin));
+    EXPECT_EQ(std::string(valueBegin, 5), "Other");
+}
+
+TEST(PropertyIndexTest, EmptyBuffer) {
+    PropertyIndex index;
+    EXPECT_FALSE(index.contains("a"));
+    index.build(nullptr, 0);
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_FALSE(index.contains(""));
+}
+
+TEST(PropertyIndexTest, SameAsFindPropertyValue) {
+    const char alphabet[] = {'a', 'b', 'A', 'B', '=', ' ', '\t', '\n', '\r', ';', '"', '\\', '#', '/', '*'};
+    const std::string names[] = {"", "a", "b", "A", "ab", "aB", "ba", "a*", "abab"};
+    std::mt19937 rng(1234);
+
+    for (int round = 0; round < 2000; ++round) {
+        std::string src(rng() % 64, ' ');
+        for (char& c : src) {
+            c = alphabet[rng() % sizeof(alphabet)];
+        }
+
+        for (const bool caseSensitive : {true, false}) {
+            PropertyIndex index(src.data(), src.size(), caseSensitive);
+            for (const std::string& name : names) {
+                const char* expected = nullptr;
+                const char* actual = nullptr;
+                const bool found = PropertyParser::findPropertyValue(src.data(), src.size(), name, expected, caseSensitive);
+                ASSERT_EQ(index.find(name, actual), found) << src;
+                ASSERT_EQ(actual, expected) << src;
+            }
+        }
+    }
+}
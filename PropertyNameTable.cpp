@@ -0,0 +1,36 @@
+#include "PropertyNameTable.h"
+
+#include "AsciiCase.h"
+
+PropertyNameTable::PropertyNameTable(bool caseInsensitive) : m_caseInsensitive(caseInsensitive) {}
+
+uint64_t PropertyNameTable::hashName(std::string_view name) const { return hashFolded(name, m_caseInsensitive); }
+
+size_t PropertyNameTable::lookup(std::string_view name, uint64_t hash) const {
+    return m_slots.probe(hash, [&](uint32_t id) {
+        return m_hashes[id] == hash && (m_caseInsensitive ? equalsFolded(m_names[id], name) : m_names[id] == name);
+    });
+}
+
+// An empty slot holds 0, which gives npos.
+uint32_t PropertyNameTable::find(std::string_view name) const { return m_slots.at(lookup(name, hashName(name))) - 1; }
+
+uint32_t PropertyNameTable::intern(std::string_view name) { return intern(name, hashName(name)); }
+
+uint32_t PropertyNameTable::intern(std::string_view name, uint64_t hash) {
+    const size_t slot = lookup(name, hash);
+    const uint32_t found = m_slots.at(slot) - 1;
+    if (found != npos || m_frozen || m_names.size() >= npos - 1) {
+        return found;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(m_names.size());
+    m_names.emplace_back(name);
+    if (m_caseInsensitive) {
+        std::string& stored = m_names.back();
+        foldAsciiCopy(stored.data(), stored.size(), &stored[0]);
+    }
+    m_hashes.push_back(hash);
+    m_slots.insert(slot, [&](size_t index) { return m_hashes[index]; });
+    return id;
+}
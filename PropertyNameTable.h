@@ -0,0 +1,58 @@
+#ifndef PROPERTY_NAME_TABLE_H
+#define PROPERTY_NAME_TABLE_H
+
+#include "HashSlots.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Interned property names with dense integer IDs (0, 1, 2, ... in the order of first appearance).
+// Attached to a parser with PropertyParser::setNameTable(), it gives every valid record the ID and
+// hash of its name, so consumers can dispatch on an ID (switch, array index) instead of comparing
+// strings. Known keys can be interned up front to get fixed IDs; a frozen table does not grow and
+// reports unknown names as npos. Names are stored once and their views stay valid while the table lives.
+class PropertyNameTable {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    // In case-insensitive mode names are folded before they are interned or looked up.
+    explicit PropertyNameTable(bool caseInsensitive = false);
+
+    // ID of name, adding it unless the table is frozen (npos then).
+    uint32_t intern(std::string_view name);
+
+    // ID of name, or npos if it was not interned.
+    uint32_t find(std::string_view name) const;
+
+    std::string_view name(uint32_t id) const { return m_names[id]; }
+    uint64_t hash(uint32_t id) const { return m_hashes[id]; }
+
+    // Hash used by the table (hashFolded(), folding in case-insensitive mode).
+    uint64_t hashName(std::string_view name) const;
+
+    size_t size() const { return m_names.size(); }
+    bool isCaseInsensitive() const { return m_caseInsensitive; }
+
+    void freeze(bool frozen = true) { m_frozen = frozen; }
+    bool isFrozen() const { return m_frozen; }
+
+    // Find or add name with its precomputed hash.
+    uint32_t intern(std::string_view name, uint64_t hash);
+
+private:
+    bool m_caseInsensitive;
+    bool m_frozen{false};
+
+    std::deque<std::string> m_names; // stored folded; a deque keeps the strings in place
+    std::vector<uint64_t> m_hashes;
+    HashSlots m_slots; // entry index = ID
+
+    // Slot of name, or the empty slot to add it at.
+    size_t lookup(std::string_view name, uint64_t hash) const;
+};
+
+#endif // PROPERTY_NAME_TABLE_H
@@ -0,0 +1,123 @@
+#include "PropertyNameTable.h"
+#include "PropertyParser.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+TEST(PropertyNameTableTest, InternAndFind) {
+    PropertyNameTable table;
+    EXPECT_EQ(table.intern("a"), 0u);
+    EXPECT_EQ(table.intern("b"), 1u);
+    EXPECT_EQ(table.intern("a"), 0u);
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.find("b"), 1u);
+    EXPECT_EQ(table.find("A"), PropertyNameTable::npos);
+    EXPECT_EQ(table.name(1), "b");
+    EXPECT_EQ(table.hash(1), table.hashName("b"));
+
+    // Views stay valid while the table grows.
+    const std::string_view first = table.name(0);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(table.intern("key" + std::to_string(i)), static_cast<uint32_t>(i + 2));
+    }
+    EXPECT_EQ(first.data(), table.name(0).data());
+    EXPECT_EQ(table.find("key999"), 1001u);
+
+    table.freeze();
+    EXPECT_EQ(table.intern("new"), PropertyNameTable::npos);
+    EXPECT_EQ(table.intern("key5"), 7u);
+    EXPECT_EQ(table.size(), 1002u);
+}
+
+TEST(PropertyNameTableTest, CaseInsensitive) {
+    PropertyNameTable table(true);
+    EXPECT_EQ(table.intern("Server.Port"), 0u);
+    EXPECT_EQ(table.intern("SERVER.PORT"), 0u);
+    EXPECT_EQ(table.find("server.port"), 0u);
+    EXPECT_EQ(table.name(0), "server.port");
+    EXPECT_EQ(table.hashName("SeRvEr.PoRt"), table.hash(0));
+}
+
+namespace {
+
+struct Dispatch {
+    std::vector<uint32_t> ids;
+    std::vector<std::string> values;
+};
+
+void collectIds(void* data, const PropertyParser& parser) {
+    Dispatch* dispatch = static_cast<Dispatch*>(data);
+    dispatch->ids.push_back(parser.getPropertyNameId());
+    dispatch->values.push_back(parser.getPropertyValue());
+}
+
+void collectBatchIds(void* data, const PropertyRecord* records, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        static_cast<std::vector<uint32_t>*>(data)->push_back(records[i].nameId);
+    }
+}
+
+} // namespace
+
+TEST(PropertyNameTableTest, ParserReportsIds) {
+    PropertyNameTable table(true);
+    enum : uint32_t { kHost, kPort };
+    ASSERT_EQ(table.intern("Host"), kHost);
+    ASSERT_EQ(table.intern("Port"), kPort);
+
+    PropertyParser parser(64, true);
+    parser.setNameTable(&table);
+    const std::string input = "PORT=80\nhost=a\nbad line\nextra=1\nHost=b\n";
+    Dispatch dispatch;
+    parser.feedAndParse(input.data(), input.size(), collectIds, &dispatch);
+    parser.finish(collectIds, &dispatch);
+
+    const std::vector<uint32_t> expected = {kPort, kHost, PropertyNameTable::npos, 2u, kHost};
+    EXPECT_EQ(dispatch.ids, expected);
+    EXPECT_EQ(dispatch.values[0], "80");
+    EXPECT_EQ(table.name(2), "extra");
+
+    // A frozen table ignores unknown names; the getters report npos and no hash.
+    table.freeze();
+    parser.feedAndParse("other=1\n", 8, [&](const PropertyParser& p) {
+        EXPECT_TRUE(p.isValid());
+        EXPECT_EQ(p.getPropertyNameId(), PropertyNameTable::npos);
+        EXPECT_EQ(p.getPropertyNameHash(), 0u);
+    });
+    EXPECT_EQ(table.size(), 3u);
+}
+
+TEST(PropertyNameTableTest, BatchAndParallelMatchSequential) {
+    std::string input;
+    for (int i = 0; i < 5000; ++i) {
+        input += "k" + std::to_string(i % 37) + "=v" + std::to_string(i) + (i % 11 == 0 ? "\\\n  tail\n" : "\n");
+    }
+
+    PropertyNameTable sequentialTable;
+    PropertyParser sequential(256);
+    sequential.setNameTable(&sequentialTable);
+    std::vector<uint32_t> expected;
+    sequential.feedAndParse(input.data(), input.size(),
+                            [&](const PropertyParser& p) { expected.push_back(p.getPropertyNameId()); });
+    sequential.finish();
+
+    PropertyNameTable batchTable;
+    PropertyParser batch(256);
+    batch.setNameTable(&batchTable);
+    std::vector<uint32_t> batchIds;
+    for (size_t offset = 0; offset < input.size(); offset += 100) {
+        batch.feedAndParseBatch(input.data() + offset, std::min<size_t>(100, input.size() - offset), collectBatchIds, &batchIds);
+    }
+    batch.finish([](void* data, const PropertyParser& p) { static_cast<std::vector<uint32_t>*>(data)->push_back(p.getPropertyNameId()); },
+                 &batchIds);
+    EXPECT_EQ(batchIds, expected);
+
+    PropertyNameTable parallelTable;
+    PropertyParser parallel(256);
+    parallel.setNameTable(&parallelTable);
+    std::vector<uint32_t> parallelIds;
+    parallel.parseParallel(input.data(), input.size(), collectBatchIds, &parallelIds, 4);
+    EXPECT_EQ(parallelIds, expected);
+    EXPECT_EQ(parallelTable.size(), 37u);
+}
@@ -1,33 +1,86 @@
 #include "PropertyParser.h"
 
+#include "AsciiCase.h"
+#include "CharClassifier.h"
+#include "MappedFile.h"
+#include "PropertyRawScanner.h"
+
 #include <algorithm>
-#include <cctype>
 #include <cstring>
+#include <thread>
+
+#ifdef PROPERTY_PARSER_STATS
+#define PROPERTY_PARSER_COUNT(statement) statement
+#else
+#define PROPERTY_PARSER_COUNT(statement) ((void)0)
+#endif
 
 namespace {
 
 inline bool isSpaceOrTab(char c) { return c == ' ' || c == '\t'; }
 
-inline char toLowerAscii(char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
-
-static std::string toLowerCopy(const std::string& s) {
-    std::string out = s;
-    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return (char)std::tolower(c); });
-    return out;
+// Fold s into storage when it has upper-case letters (in a single pass after the first one);
+// otherwise s is returned as it is and stays zero-copy.
+inline std::string_view foldedView(std::string& storage, std::string_view s) {
+    const size_t upper = findUpperAscii(s.data(), s.size());
+    if (upper == s.size()) {
+        return s;
+    }
+    storage.resize(s.size());
+    std::memcpy(&storage[0], s.data(), upper);
+    foldAsciiCopy(s.data() + upper, s.size() - upper, &storage[upper]);
+    return storage;
 }
 
-static bool equalsNameImpl(const std::string& a, const std::string& b, bool caseSensitive) {
-    if (caseSensitive) {
-        return a == b;
-    }
-    return toLowerCopy(a) == toLowerCopy(b);
+inline bool equalsNameImpl(std::string_view a, std::string_view b, bool caseSensitive) {
+    return caseSensitive ? a == b : equalsFolded(a, b);
 }
 
 } // namespace
 
 PropertyParser::PropertyParser(size_t maxBufferSize, bool caseInsensitive)
-    : m_buffer(maxBufferSize), m_isValid(false), m_caseInsensitive(caseInsensitive) {
-    m_buffer.clear(); // keep capacity, start empty
+    : m_maxBufferSize(std::max<size_t>(maxBufferSize, 1)), m_isValid(false), m_caseInsensitive(caseInsensitive) {
+    // m_buffer only holds a record split between feeds; it is allocated on first use.
+}
+
+void PropertyParser::resetTokenizer() {
+    // The next token starts from scratch right after the consumed bytes.
+    m_scanPos = 0;
+    m_tokenStarted = false;
+    m_inQuotes = false;
+    m_escape = false;
+    m_inLineComment = false;
+    m_inBlockComment = false;
+}
+
+void PropertyParser::appendBuffered(const char* data, size_t length) {
+    if (bufferedSize() == 0) {
+        // Bytes of consumed tokens are kept until more input arrives, so that result views
+        // into m_buffer stay valid; drop them now.
+        m_buffer.clear();
+        m_readPos = 0;
+        m_buffer.reserve(m_maxBufferSize);
+    } else if (m_buffer.size() + length > m_buffer.capacity()) {
+        // Only the unconsumed tail (one partial token) is moved, and only when the appended
+        // bytes would not fit behind it.
+        compactBuffer();
+    }
+    m_buffer.insert(m_buffer.end(), data, data + length);
+    PROPERTY_PARSER_COUNT(m_stats.bytesBuffered += length);
+    PROPERTY_PARSER_COUNT(m_stats.peakBufferSize = std::max<uint64_t>(m_stats.peakBufferSize, bufferedSize()));
+}
+
+void PropertyParser::compactBuffer() {
+    if (m_readPos == 0) {
+        return;
+    }
+    const size_t remaining = bufferedSize();
+    if (remaining > 0) {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_readPos, remaining);
+        PROPERTY_PARSER_COUNT(m_stats.bytesCompacted += remaining);
+    }
+    m_buffer.resize(remaining);
+    m_readPos = 0;
 }
 
 bool PropertyParser::equalsName(const std::string& a, const std::string& b, bool caseSensitive) {
@@ -35,91 +88,427 @@ bool PropertyParser::equalsName(const std::string& a, const std::string& b, bool
 }
 
 void PropertyParser::feedAndParse(const char* data, size_t length, PropertyParserCallback callback, void* callbackData) {
-    auto clearCurrentResult = [this]() {
-        m_isValid = false;
-        m_propertyName.clear();
-        m_propertyValue.clear();
-        m_propertyMatch.clear();
-    };
+    FeedPosition position = beginFeed(length);
+    while (parseNextFrom(data, length, position)) {
+        if (callback && hasRecord()) {
+            callback(callbackData, *this);
+        }
 
-    size_t processed = 0;
-    while (processed < length) {
-        const size_t availableSpace = m_buffer.capacity() - m_buffer.size();
-        const size_t toProcess = std::min(length - processed, availableSpace);
+        // Do not keep last result after feedAndParse() iteration.
+        clearResult();
+    }
+}
 
-        m_buffer.insert(m_buffer.end(), data + processed, data + processed + toProcess);
-        processed += toProcess;
+void PropertyParser::feedAndParseBatch(const char* data, size_t length, PropertyParserBatchCallback callback,
+                                       void* callbackData) {
+    m_batchEntries.clear();
+    m_batchText.clear();
 
-        // If we have a chance to parse (delimiter seen in appended chunk) or buffer full or end of input.
-        bool mayHaveToken = (processed >= length) || (m_buffer.size() >= m_buffer.capacity());
-        if (!mayHaveToken) {
-            for (size_t i = m_buffer.size() - toProcess; i < m_buffer.size(); ++i) {
-                if (m_buffer[i] == '\n' || m_buffer[i] == ';') {
-                    mayHaveToken = true;
-                    break;
-                }
-            }
+    FeedPosition position = beginFeed(length);
+    while (parseNextFrom(data, length, position)) {
+        if (hasRecord()) {
+            m_batchEntries.push_back(makeBatchEntry(currentRecord(), data, length));
         }
+        clearResult();
+    }
 
-        if (!mayHaveToken) {
-            continue;
+    m_batch.clear();
+    for (const BatchEntry& entry : m_batchEntries) {
+        m_batch.push_back(resolveBatchEntry(entry));
+    }
+
+    if (callback && !m_batch.empty()) {
+        callback(callbackData, m_batch.data(), m_batch.size());
+    }
+}
+
+PropertyParser::BatchEntry PropertyParser::makeBatchEntry(const PropertyRecord& record, const char* data, size_t length) {
+    return {makeBatchField(data, length, record.name), makeBatchField(data, length, record.value),
+            makeBatchField(data, length, record.match), record.valid, record.offset, record.nameId};
+}
+
+PropertyRecord PropertyParser::resolveBatchEntry(const BatchEntry& entry) const {
+    return {resolveBatchField(entry.name), resolveBatchField(entry.value), resolveBatchField(entry.match), entry.valid,
+            entry.offset, entry.nameId};
+}
+
+PropertyParser::BatchField PropertyParser::makeBatchField(const char* data, size_t length, std::string_view view) {
+    if (view.empty() || (view.data() >= data && view.data() + view.size() <= data + length)) {
+        return {view.data(), 0, view.size()};
+    }
+    // The view refers to parser storage that the next record overwrites: keep a copy.
+    const size_t offset = m_batchText.size();
+    m_batchText.append(view.data(), view.size());
+    return {nullptr, offset, view.size()};
+}
+
+std::string_view PropertyParser::resolveBatchField(const BatchField& field) const {
+    if (field.input || field.size == 0) {
+        return std::string_view(field.input, field.size);
+    }
+    return std::string_view(m_batchText.data() + field.offset, field.size);
+}
+
+void PropertyParser::parseParallel(const char* data, size_t length, PropertyParserBatchCallback callback,
+                                   void* callbackData, size_t threads, bool ordered) {
+    reset();
+    PROPERTY_PARSER_COUNT(m_stats.bytesFed += length);
+    if (!data || length == 0) {
+        return;
+    }
+
+    if (threads == 0) {
+        // One chunk per core, but not less than 64 KB per chunk.
+        threads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), length / (64 * 1024)));
+    }
+
+    // Speculative chunk starts: the first line start at or after every 1/threads of the input.
+    std::vector<size_t> starts{0};
+    for (size_t i = 1; i < threads; ++i) {
+        const void* newline = std::memchr(data + length / threads * i, '\n', length - length / threads * i);
+        if (!newline) {
+            break;
+        }
+        const size_t start = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+        if (start < length && start > starts.back()) {
+            starts.push_back(start);
         }
+    }
+    const size_t chunks = starts.size();
+    starts.push_back(length);
 
-        while (true) {
-            if (!parseNext()) {
-                break;
+    std::vector<PropertyParser> workers;
+    workers.reserve(chunks);
+    for (size_t i = 0; i < chunks; ++i) {
+        workers.emplace_back(m_maxBufferSize, m_caseInsensitive);
+    }
+
+    {
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < chunks; ++i) {
+            pool.emplace_back([&, i] { workers[i].parseParallelChunk(data, length, starts[i], starts[i + 1]); });
+        }
+        workers[0].parseParallelChunk(data, length, starts[0], starts[1]);
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    }
+#ifdef PROPERTY_PARSER_STATS
+    // The work of the workers counts, speculative records included.
+    for (const PropertyParser& worker : workers) {
+        const PropertyParserStats& stats = worker.m_stats;
+        m_stats.bytesScanned += stats.bytesScanned;
+        m_stats.bytesRescanned += stats.bytesRescanned;
+        m_stats.bytesBuffered += stats.bytesBuffered;
+        m_stats.bytesCompacted += stats.bytesCompacted;
+        m_stats.tokens += stats.tokens;
+        m_stats.validRecords += stats.validRecords;
+        m_stats.invalidRecords += stats.invalidRecords;
+        m_stats.forcedSplits += stats.forcedSplits;
+        m_stats.peakBufferSize = std::max(m_stats.peakBufferSize, stats.peakBufferSize);
+    }
+#endif
+
+    // Stitch: follow the real tokenizer position through the chunks. A worker step that starts at
+    // the same position is reused when it would have gone the same way: with the same fill, or when
+    // the record starts inside both fills (a fill only matters when separators run up to its end).
+    std::vector<std::vector<size_t>> accepted(chunks);
+    std::vector<size_t> cursors(chunks, 0);
+    PropertyNameTable* const nameTable = m_nameTable;
+    m_nameTable = nullptr; // names are interned after stitching, in input order
+    FeedPosition position;
+    size_t chunk = 0;
+    while (position.processed < length) {
+        while (position.processed >= starts[chunk + 1]) {
+            ++chunk;
+        }
+        refill(position, length);
+
+        PropertyParser& worker = workers[chunk];
+        const std::vector<ParallelStep>& steps = worker.m_parallelSteps;
+        size_t& cursor = cursors[chunk];
+        while (cursor < steps.size() && steps[cursor].begin < position.processed) {
+            ++cursor;
+        }
+
+        if (cursor < steps.size() && steps[cursor].begin == position.processed &&
+            reuseStep(steps[cursor], 0, data, length, position)) {
+            if (steps[cursor].entry != static_cast<size_t>(-1)) {
+                accepted[chunk].push_back(steps[cursor].entry);
             }
+            continue;
+        }
 
-            if (callback && (m_isValid || !m_propertyMatch.empty())) {
-                callback(callbackData, *this);
+        // The speculation missed this position: tokenize the record again.
+        if (!parseParallelStep(data, length, position)) {
+            break;
+        }
+        if (hasRecord()) {
+            accepted[chunk].push_back(worker.m_batchEntries.size());
+            worker.m_batchEntries.push_back(worker.makeBatchEntry(currentRecord(), data, length));
+        }
+        clearResult();
+    }
+    reset();
+    m_nameTable = nameTable;
+
+    // The workers have no name table (it is not synchronized): intern the accepted names here, in order.
+    if (m_nameTable) {
+        for (size_t i = 0; i < chunks; ++i) {
+            PropertyParser& worker = workers[i];
+            for (const size_t entry : accepted[i]) {
+                BatchEntry& e = worker.m_batchEntries[entry];
+                if (e.valid) {
+                    e.nameId = m_nameTable->intern(worker.resolveBatchField(e.name));
+                }
             }
+        }
+    }
+
+    auto deliver = [&](size_t i) {
+        PropertyParser& worker = workers[i];
+        worker.m_batch.clear();
+        for (const size_t entry : accepted[i]) {
+            worker.m_batch.push_back(worker.resolveBatchEntry(worker.m_batchEntries[entry]));
+        }
+        if (callback && !worker.m_batch.empty()) {
+            callback(callbackData, worker.m_batch.data(), worker.m_batch.size());
+        }
+    };
 
-            // Do not keep last result after feedAndParse() iteration.
-            clearCurrentResult();
+    if (ordered) {
+        for (size_t i = 0; i < chunks; ++i) {
+            deliver(i);
         }
+        return;
     }
-}
 
-bool PropertyParser::extractNextToken(std::string& token) {
-    token.clear();
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < chunks; ++i) {
+        pool.emplace_back(deliver, i);
+    }
+    deliver(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
 
-    if (m_buffer.empty()) {
+bool PropertyParser::reuseStep(const StepSpan& step, size_t offset, const char* data, size_t length,
+                               FeedPosition& position) const {
+    const size_t stepFillEnd = step.fillEnd + offset;
+    const size_t stepEnd = step.end + offset;
+    size_t nextFillEnd = step.nextFillEnd + offset;
+    bool reusable = stepFillEnd == position.fillEnd;
+    if (!reusable) {
+        // The fills differ, which only matters if separators run up to the end of one of them.
+        size_t recordStart = position.processed;
+        while (recordStart < length && (data[recordStart] == '\n' || data[recordStart] == '\r' || data[recordStart] == ';')) {
+            ++recordStart;
+        }
+        reusable = recordStart < std::min(position.fillEnd, stepFillEnd);
+        // A record that does not fit into the rest of the fill starts a new one.
+        nextFillEnd = (stepEnd <= position.fillEnd) ? position.fillEnd : fillEndFrom(position.processed, length);
+    }
+    if (!reusable) {
         return false;
     }
+    position.processed = stepEnd;
+    position.fillEnd = nextFillEnd;
+    return true;
+}
 
-    // Skip leading CR/LF and separators.
-    size_t i = 0;
-    while (i < m_buffer.size() && (m_buffer[i] == '\n' || m_buffer[i] == '\r' || m_buffer[i] == ';')) {
-        ++i;
+bool PropertyParser::parseParallelStep(const char* data, size_t length, FeedPosition& position) {
+    if (parseNextFrom(data, length, position)) {
+        return true;
     }
-    if (i >= m_buffer.size()) {
-        // Buffer has only separators; consume all.
-        m_buffer.clear();
+    if (bufferedSize() == 0) {
         return false;
     }
 
-    bool inQuotes = false;
-    bool escape = false;
+    // The input is complete: the trailing record ends with it.
+    const size_t bufferStart = length - bufferedSize();
+    const bool parsed = finishStep();
+    m_recordOffset = bufferStart + m_tokenStart;
+    return parsed;
+}
 
-    bool inLineComment = false;  // '#'
-    bool inBlockComment = false; // /* ... */
+void PropertyParser::parseParallelChunk(const char* data, size_t length, size_t begin, size_t end) {
+    FeedPosition position;
+    position.processed = begin;
+    while (position.processed < end) {
+        refill(position, length);
+
+        ParallelStep step{{position.processed, position.fillEnd, length, 0}, static_cast<size_t>(-1)};
+        const bool parsed = parseParallelStep(data, length, position);
+        if (parsed && hasRecord()) {
+            step.entry = m_batchEntries.size();
+            m_batchEntries.push_back(makeBatchEntry(currentRecord(), data, length));
+        }
+        if (parsed) {
+            step.end = position.processed;
+            step.nextFillEnd = position.fillEnd;
+        }
+        m_parallelSteps.push_back(step);
+        clearResult();
+        if (!parsed) {
+            break;
+        }
+    }
+}
+
+void PropertyParser::refill(FeedPosition& position, size_t length) const {
+    if (position.fillEnd <= position.processed) {
+        position.fillEnd = fillEndFrom(position.processed, length);
+    }
+}
+
+size_t PropertyParser::fillEndFrom(size_t processed, size_t length) const {
+    return std::min(length, processed + m_maxBufferSize);
+}
+
+PropertyParser::FeedPosition PropertyParser::beginFeed(size_t length) {
+    PROPERTY_PARSER_COUNT(m_stats.bytesFed += length);
+    FeedPosition position;
+    position.fillEnd = std::min(length, m_maxBufferSize - bufferedSize());
+    return position;
+}
+
+bool PropertyParser::parseNextFrom(const char* data, size_t length, FeedPosition& position) {
+    clearResult();
+
+    // The tokenizer sees the input in fills, as if it was copied into a buffer of m_maxBufferSize
+    // bytes: a fill starts at the record that needed more data and ends at position.fillEnd.
+    // Fills decide where a record longer than the buffer is split and which separators are dropped.
+
+    // A record left incomplete by a previous feed continues in m_buffer. Input is appended up to
+    // the next byte that may end it, so that only the bytes of that record are copied.
+    while (bufferedSize() > 0 && position.processed < position.fillEnd) {
+        const char* begin = data + position.processed;
+        const char* end = data + position.fillEnd;
+        const char* stop = begin;
+        while (stop < end && *stop != '\n' && *stop != ';') {
+            ++stop;
+        }
+        if (stop < end) {
+            ++stop; // include the delimiter candidate
+        }
+
+        appendBuffered(begin, static_cast<size_t>(stop - begin));
+        position.processed += static_cast<size_t>(stop - begin);
+
+        size_t consumed = 0;
+        const bool complete = extractNextToken(m_buffer.data() + m_readPos, bufferedSize(), consumed);
+        m_readPos += consumed;
+        if (complete) {
+            // Bytes appended past the end of the token go back to the direct path below.
+            position.processed -= bufferedSize();
+            m_buffer.resize(m_readPos);
+            m_recordOffset = 0;
+            emitToken();
+            return true;
+        }
+    }
+    if (bufferedSize() > 0) {
+        return false; // input exhausted in the middle of a record
+    }
+
+    // Complete records are tokenized in place in the caller's data.
+    while (position.processed < length) {
+        refill(position, length);
+
+        const size_t windowStart = position.processed;
+        size_t consumed = 0;
+        const bool complete = extractNextToken(data + windowStart, position.fillEnd - windowStart, consumed);
+        position.processed += consumed;
+        if (complete) {
+            m_recordOffset = windowStart + m_tokenStart;
+            emitToken();
+            return true;
+        }
+        if (consumed > 0) {
+            continue; // the fill held only separators
+        }
+
+        const size_t refillEnd = fillEndFrom(position.processed, length);
+        if (refillEnd > position.fillEnd) {
+            position.fillEnd = refillEnd; // resume the same record with a larger fill
+            continue;
+        }
+
+        // Only the trailing partial record is copied; the tokenizer state refers to it.
+        appendBuffered(data + position.processed, length - position.processed);
+        position.processed = length;
+    }
+    return false;
+}
+
+bool PropertyParser::extractNextToken(const char* buf, size_t size, size_t& consumed) {
+    consumed = 0;
+
+    // A full buffer cannot grow anymore: bytes past its end read as '\0' (no lookahead).
+    // Otherwise a byte whose meaning depends on the following ones is left for the next call.
+    const bool full = size >= m_maxBufferSize || m_endOfInput;
+    auto needMore = [&](size_t pos, size_t ahead) { return !full && pos + ahead >= size; };
+
+    size_t endIndex = m_scanPos;
+#ifdef PROPERTY_PARSER_STATS
+    const size_t scanStart = m_scanPos;
+#endif
+
+    if (!m_tokenStarted) {
+        // Skip leading CR/LF and separators.
+        while (endIndex < size && (buf[endIndex] == '\n' || buf[endIndex] == '\r' || buf[endIndex] == ';')) {
+            ++endIndex;
+        }
+        if (endIndex >= size) {
+            // Buffer has only separators; consume all.
+            PROPERTY_PARSER_COUNT(m_stats.bytesScanned += size - scanStart);
+            consumed = size;
+            resetTokenizer();
+            return false;
+        }
+        m_tokenStarted = true;
+        m_tokenStart = endIndex;
+        m_token.clear();
+        m_tokenContiguous = true;
+        m_tokenBegin = 0;
+        m_tokenEnd = 0;
+    }
 
     bool sawDelimiter = false;
-    size_t endIndex = i;
+    bool needMoreData = false;
+
+    // Continue building the token from where the previous call stopped; every byte is examined once.
+    for (; endIndex < size; ++endIndex) {
+        const char c = buf[endIndex];
+
+        if (!isSpecialChar(c)) {
+            // Ordinary text does not change the state: find the next special byte and take the
+            // whole run at once (skipped inside comments, appended to the token otherwise).
+            const size_t runEnd = static_cast<size_t>(findSpecialChar(buf + endIndex + 1, buf + size) - buf);
+            if (!m_inLineComment && !m_inBlockComment) {
+                m_escape = false;
+                appendTokenBytes(buf, endIndex, runEnd - endIndex);
+            }
+            endIndex = runEnd - 1; // the loop increment moves to the special byte
+            continue;
+        }
+
+        const char next = (endIndex + 1 < size) ? buf[endIndex + 1] : '\0';
+        const char next2 = (endIndex + 2 < size) ? buf[endIndex + 2] : '\0';
 
-    // Build token while tracking endIndex (where delimiter starts or buffer ends).
-    for (; endIndex < m_buffer.size(); ++endIndex) {
-        const char c = m_buffer[endIndex];
-        const char next = (endIndex + 1 < m_buffer.size()) ? m_buffer[endIndex + 1] : '\0';
-        const char next2 = (endIndex + 2 < m_buffer.size()) ? m_buffer[endIndex + 2] : '\0';
+        if (c == '\r' && needMore(endIndex, 1)) {
+            needMoreData = true;
+            break;
+        }
 
         // Handle CRLF as newline delimiter.
         const bool isCRLF = (c == '\r' && next == '\n');
         const bool isBackslashCRLF = (c == '\\' && next == '\r' && next2 == '\n');
 
-        if (inLineComment) {
+        if (m_inLineComment) {
             if (c == '\n' || isCRLF) {
-                inLineComment = false;
+                m_inLineComment = false;
                 // This newline is a delimiter. Stop token.
                 sawDelimiter = true;
                 break;
@@ -128,28 +517,40 @@ bool PropertyParser::extractNextToken(std::string& token) {
             continue;
         }
 
-        if (inBlockComment) {
+        if (m_inBlockComment) {
+            if (c == '*' && needMore(endIndex, 1)) {
+                needMoreData = true;
+                break;
+            }
             if (c == '*' && next == '/') {
-                inBlockComment = false;
+                m_inBlockComment = false;
                 ++endIndex; // consume '/'
             }
             continue;
         }
 
-        if (!inQuotes) {
+        if (!m_inQuotes) {
             // Start comments (ignored)
             if (c == '#') {
-                inLineComment = true;
+                m_inLineComment = true;
                 continue;
             }
+            if (c == '/' && needMore(endIndex, 1)) {
+                needMoreData = true;
+                break;
+            }
             if (c == '/' && next == '*') {
-                inBlockComment = true;
+                m_inBlockComment = true;
                 ++endIndex; // consume '*'
                 continue;
             }
 
             // Line continuation: backslash immediately before newline (LF or CRLF)
             if (c == '\\') {
+                if (needMore(endIndex, 1) || (next == '\r' && needMore(endIndex, 2))) {
+                    needMoreData = true;
+                    break;
+                }
                 if (next == '\n') {
                     ++endIndex; // consume '\n'
                     continue;   // continue token
@@ -178,12 +579,12 @@ bool PropertyParser::extractNextToken(std::string& token) {
 
             // Quoted string start (value may start with quotes)
             if (c == '"') {
-                inQuotes = true;
-                token.push_back(c);
+                m_inQuotes = true;
+                appendTokenBytes(buf, endIndex, 1);
                 continue;
             }
 
-            token.push_back(c);
+            appendTokenBytes(buf, endIndex, 1);
             continue;
         }
 
@@ -194,71 +595,94 @@ bool PropertyParser::extractNextToken(std::string& token) {
             break;
         }
 
-        if (escape) {
-            token.push_back(c);
-            escape = false;
+        if (m_escape) {
+            appendTokenBytes(buf, endIndex, 1);
+            m_escape = false;
             continue;
         }
 
         if (c == '\\') {
             // Escape inside string (for escaped quotes etc.)
-            token.push_back(c);
-            escape = true;
+            appendTokenBytes(buf, endIndex, 1);
+            m_escape = true;
             continue;
         }
 
         if (c == '"') {
-            token.push_back(c);
-            inQuotes = false;
+            appendTokenBytes(buf, endIndex, 1);
+            m_inQuotes = false;
             continue;
         }
 
-        token.push_back(c);
+        appendTokenBytes(buf, endIndex, 1);
     }
 
     // Determine how many bytes to consume from buffer:
-    // from 0..endIndex plus delimiter bytes (if present) plus leading skipped part (i).
+    // from 0..endIndex plus delimiter bytes (if present), including the leading skipped separators.
     size_t removeEnd = endIndex;
     if (sawDelimiter) {
         // Consume delimiter bytes too
-        if (removeEnd < m_buffer.size() && m_buffer[removeEnd] == '\r') {
+        if (removeEnd < size && buf[removeEnd] == '\r') {
             ++removeEnd;
         }
-        if (removeEnd < m_buffer.size() && m_buffer[removeEnd] == '\n') {
+        if (removeEnd < size && buf[removeEnd] == '\n') {
             ++removeEnd;
         }
-        if (endIndex < m_buffer.size() && m_buffer[endIndex] == ';') {
+        if (endIndex < size && buf[endIndex] == ';') {
             ++removeEnd;
         }
+    } else if (full && !needMoreData) {
+        // No delimiter found and buffer is full - treat buffer as a token (consume all).
+        removeEnd = size;
+        PROPERTY_PARSER_COUNT(++m_stats.forcedSplits);
     } else {
-        // No delimiter found.
-        // If buffer is full - treat buffer as a token (consume all).
-        if (m_buffer.size() >= m_buffer.capacity()) {
-            removeEnd = m_buffer.size();
-        } else {
-            // Need more data for complete token
-            return false;
-        }
+        // Need more data for complete token: remember where to resume.
+        // The byte that needs lookahead is examined again on the next call.
+        PROPERTY_PARSER_COUNT(m_stats.bytesScanned += endIndex - scanStart);
+        PROPERTY_PARSER_COUNT(m_stats.bytesRescanned += needMoreData ? 1 : 0);
+        m_scanPos = endIndex;
+        return false;
     }
+    PROPERTY_PARSER_COUNT(m_stats.bytesScanned += removeEnd - scanStart);
 
-    // Remove leading skipped bytes too (separators at start)
-    // If we started at i > 0, we need to also drop that prefix.
-    // We built token from position i..endIndex.
-    const size_t toErase = (removeEnd > 0) ? removeEnd : 0;
-    if (toErase >= m_buffer.size()) {
-        m_buffer.clear();
-    } else {
-        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + toErase);
-    }
+    // Contiguous tokens are handed out as a view into the scanned input.
+    m_tokenView = m_tokenContiguous ? std::string_view(buf + m_tokenBegin, m_tokenEnd - m_tokenBegin) : std::string_view(m_token);
 
+    consumed = removeEnd;
+    resetTokenizer();
     return true;
 }
 
-bool PropertyParser::parseToken(const std::string& token) {
-    m_isValid = false;
-    m_propertyName.clear();
-    m_propertyValue.clear();
-    m_propertyMatch.clear();
+void PropertyParser::emitToken() {
+    (void)parseToken(m_tokenView);
+    PROPERTY_PARSER_COUNT(++m_stats.tokens);
+    PROPERTY_PARSER_COUNT(++(m_isValid ? m_stats.validRecords : m_stats.invalidRecords));
+}
+
+void PropertyParser::appendTokenBytes(const char* buf, size_t pos, size_t count) {
+    if (m_tokenContiguous) {
+        if (m_tokenBegin == m_tokenEnd) {
+            m_tokenBegin = pos;
+            m_tokenEnd = pos + count;
+            return;
+        }
+        if (m_tokenEnd == pos) {
+            m_tokenEnd += count;
+            return;
+        }
+        // A byte was skipped (whitespace, comment, line continuation): switch to the copying path.
+        m_token.assign(buf + m_tokenBegin, m_tokenEnd - m_tokenBegin);
+        m_tokenContiguous = false;
+    }
+    m_token.append(buf + pos, count);
+}
+
+void PropertyParser::setPropertyMatch(std::string_view token) {
+    m_propertyMatchView = m_caseInsensitive ? foldedView(m_propertyMatch, token) : token;
+}
+
+bool PropertyParser::parseToken(std::string_view token) {
+    clearResult();
 
     if (token.empty()) {
         return false;
@@ -285,358 +709,228 @@ bool PropertyParser::parseToken(const std::string& token) {
         }
         if ((quoteCount % 2) != 0) {
             // Malformed token: unclosed string
-            m_propertyMatch = token;
-            if (m_caseInsensitive) {
-                std::transform(m_propertyMatch.begin(), m_propertyMatch.end(), m_propertyMatch.begin(),
-                               [](unsigned char c) { return (char)std::tolower(c); });
-            }
+            setPropertyMatch(token);
             return false;
         }
     }
 
     const size_t eqPos = token.find('=');
-    if (eqPos == std::string::npos) {
-        m_propertyMatch = token;
-        if (m_caseInsensitive) {
-            std::transform(m_propertyMatch.begin(), m_propertyMatch.end(), m_propertyMatch.begin(),
-                           [](unsigned char c) { return (char)std::tolower(c); });
-        }
+    if (eqPos == std::string_view::npos || eqPos == 0) {
+        // No separator or empty name
+        setPropertyMatch(token);
         return false;
     }
 
-    if (eqPos == 0) {
-        // Empty name
-        m_propertyMatch = token;
-        if (m_caseInsensitive) {
-            std::transform(m_propertyMatch.begin(), m_propertyMatch.end(), m_propertyMatch.begin(),
-                           [](unsigned char c) { return (char)std::tolower(c); });
-        }
-        return false;
-    }
+    std::string_view name = token.substr(0, eqPos);
+    std::string_view value = token.substr(eqPos + 1);
 
-    m_propertyName = token.substr(0, eqPos);
-    m_propertyValue = token.substr(eqPos + 1);
+    // If value is quoted string - unescape \" and \\ and remove outer quotes.
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        value = value.substr(1, value.size() - 2);
 
-    if (m_propertyName.empty()) {
-        m_propertyMatch = token;
-        if (m_caseInsensitive) {
-            std::transform(m_propertyMatch.begin(), m_propertyMatch.end(), m_propertyMatch.begin(),
-                           [](unsigned char c) { return (char)std::tolower(c); });
+        if (value.find('\\') != std::string_view::npos) {
+            m_propertyValue.clear();
+            m_propertyValue.reserve(value.size());
+
+            bool esc = false;
+            for (const char c : value) {
+                if (esc) {
+                    m_propertyValue.push_back(c);
+                    esc = false;
+                } else if (c == '\\') {
+                    esc = true;
+                } else {
+                    m_propertyValue.push_back(c);
+                }
+            }
+
+            if (esc) {
+                // Trailing backslash inside quotes -> malformed
+                setPropertyMatch(token);
+                return false;
+            }
+
+            value = m_propertyValue;
         }
-        return false;
     }
 
     if (m_caseInsensitive) {
-        std::transform(m_propertyName.begin(), m_propertyName.end(), m_propertyName.begin(),
-                       [](unsigned char c) { return (char)std::tolower(c); });
+        name = foldedView(m_propertyName, name);
     }
 
-    // If value is quoted string - unescape \" and \\ and remove outer quotes.
-    if (m_propertyValue.size() >= 2 && m_propertyValue.front() == '"' && m_propertyValue.back() == '"') {
-        std::string unescaped;
-        unescaped.reserve(m_propertyValue.size());
+    m_propertyNameView = name;
+    m_propertyValueView = value;
+    m_isValid = true;
 
-        bool esc = false;
-        for (size_t i = 1; i + 1 < m_propertyValue.size(); ++i) {
-            const char c = m_propertyValue[i];
-            if (esc) {
-                unescaped.push_back(c);
-                esc = false;
-            } else if (c == '\\') {
-                esc = true;
-            } else {
-                unescaped.push_back(c);
-            }
+    if (m_nameTable) {
+        m_propertyNameId = m_nameTable->intern(name);
+        if (m_propertyNameId != PropertyNameTable::npos) {
+            m_propertyNameHash = m_nameTable->hash(m_propertyNameId);
         }
+    }
+    return true;
+}
 
-        if (esc) {
-            // Trailing backslash inside quotes -> malformed
-            m_propertyMatch = token;
-            if (m_caseInsensitive) {
-                std::transform(m_propertyMatch.begin(), m_propertyMatch.end(), m_propertyMatch.begin(),
-                               [](unsigned char c) { return (char)std::tolower(c); });
-            }
-            m_propertyName.clear();
-            m_propertyValue.clear();
-            return false;
+void PropertyParser::clearResult() {
+    m_isValid = false;
+    m_propertyNameId = PropertyNameTable::npos;
+    m_propertyNameHash = 0;
+    m_propertyNameView = {};
+    m_propertyValueView = {};
+    m_propertyMatchView = {};
+}
+
+void PropertyParser::finish(PropertyParserCallback callback, void* callbackData) {
+    while (finishStep()) {
+        if (callback && hasRecord()) {
+            callback(callbackData, *this);
         }
+        clearResult();
+    }
+}
 
-        m_propertyValue = unescaped;
+bool PropertyParser::finishStep() {
+    m_endOfInput = true;
+    const bool parsed = bufferedSize() > 0 && parseNext();
+    m_endOfInput = false;
+    if (!parsed) {
+        resetTokenizer();
     }
+    return parsed;
+}
 
-    m_isValid = true;
+bool PropertyParser::parseFile(const std::string& path, PropertyParserCallback callback, void* callbackData) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    reset();
+    feedAndParse(file.data(), file.size(), callback, callbackData);
+    finish(callback, callbackData);
     return true;
 }
 
 bool PropertyParser::parseNext() {
     // Reset result
-    m_isValid = false;
-    m_propertyName.clear();
-    m_propertyValue.clear();
-    m_propertyMatch.clear();
+    clearResult();
 
-    std::string token;
-    if (!extractNextToken(token)) {
+    size_t consumed = 0;
+    const bool complete = extractNextToken(m_buffer.data() + m_readPos, bufferedSize(), consumed);
+    m_readPos += consumed;
+    if (!complete) {
         return false; // no complete token
     }
 
-    (void)parseToken(token);
+    emitToken();
     return true; // token consumed even if invalid
 }
 
 bool PropertyParser::isValid() const { return m_isValid; }
 
-const std::string& PropertyParser::getPropertyName() const { return m_propertyName; }
+const std::string& PropertyParser::getPropertyName() const { return materialize(m_propertyName, m_propertyNameView); }
+
+const std::string& PropertyParser::getPropertyValue() const { return materialize(m_propertyValue, m_propertyValueView); }
+
+const std::string& PropertyParser::getPropertyMatch() const { return materialize(m_propertyMatch, m_propertyMatchView); }
+
+std::string_view PropertyParser::getPropertyNameView() const { return m_propertyNameView; }
 
-const std::string& PropertyParser::getPropertyValue() const { return m_propertyValue; }
+std::string_view PropertyParser::getPropertyValueView() const { return m_propertyValueView; }
 
-const std::string& PropertyParser::getPropertyMatch() const { return m_propertyMatch; }
+std::string_view PropertyParser::getPropertyMatchView() const { return m_propertyMatchView; }
+
+const std::string& PropertyParser::materialize(std::string& storage, std::string_view& view) {
+    // The view either already refers to the storage (rewritten token) or into the input buffer.
+    if (view.data() != storage.data() || view.size() != storage.size()) {
+        storage.assign(view.data(), view.size());
+        view = storage;
+    }
+    return storage;
+}
 
 void PropertyParser::reset() {
+    resetTokenizer();
     m_buffer.clear();
-    m_propertyName.clear();
-    m_propertyValue.clear();
-    m_propertyMatch.clear();
-    m_isValid = false;
+    m_readPos = 0;
+    m_token.clear();
+    m_tokenView = {};
+    clearResult();
 }
 
 bool PropertyParser::matchesPattern(const std::string& str, const std::string& pattern, bool caseSensitive) {
-    std::string strCopy = str;
-    std::string patternCopy = pattern;
-
-    if (!caseSensitive) {
-        std::transform(strCopy.begin(), strCopy.end(), strCopy.begin(),
-                       [](unsigned char c) { return (char)std::tolower(c); });
-        std::transform(patternCopy.begin(), patternCopy.end(), patternCopy.begin(),
-                       [](unsigned char c) { return (char)std::tolower(c); });
-    }
-
-    size_t strIndex = 0;
-    size_t patternIndex = 0;
-    size_t starIndex = std::string::npos;
-    size_t matchIndex = 0;
-
-    while (strIndex < strCopy.length()) {
-        if (patternIndex < patternCopy.length() &&
-            (patternCopy[patternIndex] == '?' || patternCopy[patternIndex] == strCopy[strIndex])) {
-            strIndex++;
-            patternIndex++;
-        } else if (patternIndex < patternCopy.length() && patternCopy[patternIndex] == '*') {
-            starIndex = patternIndex;
-            matchIndex = strIndex;
-            patternIndex++;
-        } else if (starIndex != std::string::npos) {
-            patternIndex = starIndex + 1;
-            matchIndex++;
-            strIndex = matchIndex;
+    // Greedy matching that only ever backtracks to the last '*': a later star can absorb anything
+    // an earlier one could, so this needs no allocation (CompiledPattern is faster for reuse).
+    const size_t npos = std::string::npos;
+    size_t s = 0;
+    size_t p = 0;
+    size_t starPattern = npos; // pattern position after the last '*'
+    size_t starString = 0;     // string position that '*' matched up to
+    while (s < str.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            starPattern = ++p;
+            starString = s;
+        } else if (p < pattern.size() &&
+                   (pattern[p] == '?' || (caseSensitive ? pattern[p] == str[s] : foldAscii(pattern[p]) == foldAscii(str[s])))) {
+            ++p;
+            ++s;
+        } else if (starPattern != npos) {
+            p = starPattern;
+            s = ++starString;
         } else {
             return false;
         }
     }
-
-    while (patternIndex < patternCopy.length() && patternCopy[patternIndex] == '*') {
-        patternIndex++;
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
     }
-
-    return patternIndex == patternCopy.length();
+    return p == pattern.size();
 }
 
 bool PropertyParser::findPropertyValue(const char* data, size_t length, const std::string& name,
                                       const char*& valueBegin, bool caseSensitive) {
     valueBegin = nullptr;
-    if (!data || length == 0) {
-        return false;
-    }
 
-    auto isDelimiter = [](char c) { return c == '\n' || c == ';'; };
-
-    bool inQuotes = false;
-    bool escape = false;
-    bool inLineComment = false;
-    bool inBlockComment = false;
-
-    size_t tokenStart = 0;
-
-    auto skipSeparators = [&](size_t& pos) {
-        while (pos < length && (data[pos] == '\n' || data[pos] == '\r' || data[pos] == ';')) {
-            ++pos;
-        }
-    };
-
-    size_t pos = 0;
-    while (pos < length) {
-        skipSeparators(pos);
-        if (pos >= length) {
-            break;
+    PropertyRawScanner scanner(data, length);
+    while (scanner.next()) {
+        if (equalsNameImpl(scanner.name(), name, caseSensitive)) {
+            valueBegin = scanner.valueBegin();
+            return true;
         }
-        tokenStart = pos;
-
-        // Find token end (similar rules as tokenizer, but we want raw pointer to value start).
-        inQuotes = false;
-        escape = false;
-        inLineComment = false;
-        inBlockComment = false;
-
-        size_t tokenEnd = pos;
-        for (; tokenEnd < length; ++tokenEnd) {
-            const char c = data[tokenEnd];
-            const char next = (tokenEnd + 1 < length) ? data[tokenEnd + 1] : '\0';
-            const bool isCRLF = (c == '\r' && next == '\n');
-
-            if (inLineComment) {
-                if (c == '\n' || isCRLF) {
-                    break;
-                }
-                continue;
-            }
-            if (inBlockComment) {
-                if (c == '*' && next == '/') {
-                    inBlockComment = false;
-                    ++tokenEnd;
-                }
-                continue;
-            }
-
-            if (!inQuotes) {
-                if (c == '#') {
-                    inLineComment = true;
-                    continue;
-                }
-                if (c == '/' && next == '*') {
-                    inBlockComment = true;
-                    ++tokenEnd;
-                    continue;
-                }
-                if (c == '\\') {
-                    if (next == '\n') {
-                        ++tokenEnd;
-                        continue;
-                    }
-                    if (isCRLF) {
-                        tokenEnd += 1;
-                        continue;
-                    }
-                }
-                if (isDelimiter(c) || isCRLF || c == ';') {
-                    break;
-                }
-                if (c == '"') {
-                    inQuotes = true;
-                }
-                continue;
-            } else {
-                if (escape) {
-                    escape = false;
-                    continue;
-                }
-                if (c == '\\') {
-                    escape = true;
-                    continue;
-                }
-                if (c == '"') {
-                    inQuotes = false;
-                    continue;
-                }
-            }
-        }
-
-        // Now we have [tokenStart, tokenEnd) in original buffer (delimiter at tokenEnd or end).
-        // Find '=' and compare names (ignoring spaces/tabs and comments is hard here; we approximate by skipping spaces/tabs).
-        // We'll scan from tokenStart to tokenEnd to find '=' outside quotes/comments.
-        bool localInQuotes = false;
-        bool localEscape = false;
-        bool localLineComment = false;
-        bool localBlockComment = false;
-
-        size_t eqPos = std::string::npos;
-
-        for (size_t i = tokenStart; i < tokenEnd; ++i) {
-            const char c = data[i];
-            const char next = (i + 1 < tokenEnd) ? data[i + 1] : '\0';
-
-            if (localLineComment) {
-                break;
-            }
-            if (localBlockComment) {
-                if (c == '*' && next == '/') {
-                    localBlockComment = false;
-                    ++i;
-                }
-                continue;
-            }
+    }
 
-            if (!localInQuotes) {
-                if (c == '#') {
-                    localLineComment = true;
-                    break;
-                }
-                if (c == '/' && next == '*') {
-                    localBlockComment = true;
-                    ++i;
-                    continue;
-                }
-                if (c == '"') {
-                    localInQuotes = true;
-                    continue;
-                }
-                if (c == '=') {
-                    eqPos = i;
-                    break;
-                }
-            } else {
-                if (localEscape) {
-                    localEscape = false;
-                    continue;
-                }
-                if (c == '\\') {
-                    localEscape = true;
-                    continue;
-                }
-                if (c == '"') {
-                    localInQuotes = false;
-                    continue;
-                }
-            }
-        }
+    return false;
+}
 
-        if (eqPos != std::string::npos && eqPos > tokenStart) {
-            // Extract name portion: [tokenStart, eqPos)
-            std::string key;
-            for (size_t i = tokenStart; i < eqPos; ++i) {
-                const char c = data[i];
-                if (isSpaceOrTab(c)) {
-                    continue;
-                }
-                if (c == '/' && (i + 1 < eqPos) && data[i + 1] == '*') {
-                    // stop on comment start inside key
-                    break;
-                }
-                if (c == '#') {
-                    break;
-                }
-                key.push_back(c);
-            }
+bool PropertyParser::findPropertyValue(const MappedFile& file, const std::string& name, const char*& valueBegin,
+                                      bool caseSensitive) {
+    return findPropertyValue(file.data(), file.size(), name, valueBegin, caseSensitive);
+}
 
-            if (equalsNameImpl(key, name, caseSensitive)) {
-                // value begin is first non-space/tab after '='
-                size_t vb = eqPos + 1;
-                while (vb < tokenEnd && isSpaceOrTab(data[vb])) {
-                    ++vb;
-                }
-                valueBegin = data + vb;
-                return true;
+size_t PropertyParser::findPropertyValues(const char* data, size_t length, const std::string* names, size_t count,
+                                          const char** valueBegins, bool caseSensitive) {
+    // Requested names ordered by length: a scanned name is only compared with the names of its length.
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+        valueBegins[i] = nullptr;
+    }
+    std::sort(order.begin(), order.end(), [names](size_t a, size_t b) { return names[a].size() < names[b].size(); });
+    const auto shorter = [names](size_t index, size_t size) { return names[index].size() < size; };
+
+    size_t remaining = count;
+    PropertyRawScanner scanner(data, length);
+    while (remaining > 0 && scanner.next()) {
+        const std::string& key = scanner.name();
+        for (auto it = std::lower_bound(order.begin(), order.end(), key.size(), shorter);
+             it != order.end() && names[*it].size() == key.size(); ++it) {
+            if (valueBegins[*it] == nullptr && equalsNameImpl(names[*it], key, caseSensitive)) {
+                // The first occurrence wins, like in findPropertyValue()
+                valueBegins[*it] = scanner.valueBegin();
+                --remaining;
             }
         }
-
-        // Move pos to delimiter / next token start
-        pos = tokenEnd;
-        // Consume CRLF as delimiter
-        if (pos < length && data[pos] == '\r' && (pos + 1 < length) && data[pos + 1] == '\n') {
-            pos += 2;
-        } else if (pos < length && (data[pos] == '\n' || data[pos] == ';')) {
-            pos += 1;
-        }
     }
 
-    return false;
+    return count - remaining;
 }
@@ -1,16 +1,51 @@
 #ifndef PROPERTY_PARSER_H
 #define PROPERTY_PARSER_H
 
+#include "PropertyNameTable.h"
+
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 // Forward declaration for callback function
 class PropertyParser;
+class MappedFile;
 
 // Callback function type: takes a void pointer and a reference to the parser object
 typedef void (*PropertyParserCallback)(void*, const PropertyParser&);
 
+// One record of a batch: the same results as the parser getters, as views.
+struct PropertyRecord {
+    std::string_view name;
+    std::string_view value;
+    std::string_view match;
+    bool valid;
+    size_t offset; // first byte of the record in the data passed to the call (0 if it began in an earlier feed)
+    uint32_t nameId{PropertyNameTable::npos}; // ID of name in the parser's name table (npos without one)
+};
+
+// Counters of the work done by a parser, for sizing maxBufferSize and spotting pathological input.
+// They are only collected when the library is built with PROPERTY_PARSER_STATS defined (CMake
+// option PROP_PARSER_STATS); otherwise they stay zero and counting compiles to nothing.
+struct PropertyParserStats {
+    uint64_t bytesFed{0};        // bytes passed to the feed functions
+    uint64_t bytesScanned{0};    // bytes examined by the tokenizer
+    uint64_t bytesRescanned{0};  // bytes examined again when a token is resumed after a feed
+    uint64_t bytesBuffered{0};   // bytes copied into the internal buffer (records split between feeds)
+    uint64_t bytesCompacted{0};  // bytes moved by buffer compaction
+    uint64_t tokens{0};          // tokens parsed
+    uint64_t validRecords{0};    // tokens that were valid properties
+    uint64_t invalidRecords{0};  // other tokens
+    uint64_t forcedSplits{0};    // tokens cut because maxBufferSize bytes held no delimiter
+    uint64_t peakBufferSize{0};  // largest number of bytes held in the internal buffer
+};
+
+// Batch callback type: takes a void pointer and all records found in one feed
+typedef void (*PropertyParserBatchCallback)(void*, const PropertyRecord* records, size_t count);
+
 class PropertyParser {
 public:
     // Legacy/extended constructor that allows controlling internal buffer size
@@ -20,10 +55,53 @@ public:
     void feedAndParse(const char* data, size_t length, PropertyParserCallback callback = nullptr,
                       void* callbackData = nullptr);
 
+    // Feed data to the parser and call onRecord(const PropertyParser&) for every record.
+    // The functor is called directly (no void* context, no indirect call), so a lambda can be
+    // inlined into the parse loop.
+    template <class F, class = std::enable_if_t<std::is_invocable_v<F&, const PropertyParser&>>>
+    void feedAndParse(const char* data, size_t length, F&& onRecord) {
+        FeedPosition position = beginFeed(length);
+        while (parseNextFrom(data, length, position)) {
+            if (hasRecord()) {
+                onRecord(static_cast<const PropertyParser&>(*this));
+            }
+
+            // Do not keep last result after feedAndParse() iteration.
+            clearResult();
+        }
+    }
+
+    // Feed data to the parser and deliver every record found in it with a single callback call.
+    // The record array is reused between feeds; its views stay valid until the callback returns.
+    void feedAndParseBatch(const char* data, size_t length, PropertyParserBatchCallback callback,
+                           void* callbackData = nullptr);
+
+    // Parse a complete input on several threads; the records are the same as reset(),
+    // feedAndParse() and finish() would produce. The input is split into chunks at line starts and
+    // every chunk is tokenized speculatively on its own thread, then the chunks are stitched in order:
+    // records whose start the speculation got wrong (a chunk starting inside quotes, a comment or a
+    // continued line) are tokenized again. Records are delivered one batch per chunk; ordered batches
+    // come in input order on the calling thread, unordered ones from the worker threads concurrently
+    // (use PropertyRecord::offset to order them). threads == 0 picks one thread per core, fewer for
+    // small inputs. The parser is left reset.
+    void parseParallel(const char* data, size_t length, PropertyParserBatchCallback callback,
+                       void* callbackData = nullptr, size_t threads = 0, bool ordered = true);
+
+    // Signal the end of the input: the record left incomplete by the last feed (one that is not
+    // followed by a delimiter) is parsed and delivered like feedAndParse() does.
+    void finish(PropertyParserCallback callback = nullptr, void* callbackData = nullptr);
+
+    // Parse a whole file: the parser is reset, the file is mapped read-only and tokenized straight
+    // from the mapping (result views point into it while the callback runs), then finish() is called.
+    // Returns false if the file cannot be opened.
+    bool parseFile(const std::string& path, PropertyParserCallback callback = nullptr, void* callbackData = nullptr);
+
     // Parse next token from internal buffer. Returns true if a token was consumed.
     bool parseNext();
 
-    // Get parsing results
+    // Get parsing results. The string getters are const, but the first call copies the result into
+    // the parser and points the matching view at the copy; a parser must therefore not be read from
+    // several threads at once, not even through const getters only. Copy the values out instead.
     bool isValid() const;
     const std::string& getPropertyName() const;
     const std::string& getPropertyValue() const;
@@ -31,9 +109,33 @@ public:
     // If a token does not contain '=', it is stored here.
     const std::string& getPropertyMatch() const;
 
+    // Zero-copy variants of the getters above. When the token needed no rewriting (no comments,
+    // escapes, line continuations or case folding) the views point straight into the parser's
+    // input buffer; they are valid until the next token is parsed (in a callback: until it returns).
+    std::string_view getPropertyNameView() const;
+    std::string_view getPropertyValueView() const;
+    std::string_view getPropertyMatchView() const;
+
+    // Attach a name table (nullptr detaches it; the parser does not own it). The name of every valid
+    // record is then interned, and its ID and hash are reported with the record. A frozen table only
+    // recognizes the names already in it. The table is not synchronized: the parser must be the only
+    // one using it while parsing. Use a case-insensitive table with a case-insensitive parser, so that
+    // keys interned up front are folded like the parsed names.
+    void setNameTable(PropertyNameTable* table) { m_nameTable = table; }
+    PropertyNameTable* getNameTable() const { return m_nameTable; }
+
+    // ID and hash of the name of the current record in the name table; npos and 0 without a table,
+    // for invalid records and for names a frozen table does not know.
+    uint32_t getPropertyNameId() const { return m_propertyNameId; }
+    uint64_t getPropertyNameHash() const { return m_propertyNameHash; }
+
     // Clear parser state
     void reset();
 
+    // Statistics since construction or the last resetStats() (see PropertyParserStats).
+    const PropertyParserStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = PropertyParserStats(); }
+
     // Pattern matching functionality
     static bool matchesPattern(const std::string& str, const std::string& pattern, bool caseSensitive = true);
 
@@ -43,21 +145,178 @@ public:
     static bool findPropertyValue(const char* data, size_t length, const std::string& name,
                                   const char*& valueBegin, bool caseSensitive = true);
 
+    // Same for the contents of a mapped file; valueBegin points into the mapping and stays valid
+    // while the file is open.
+    static bool findPropertyValue(const MappedFile& file, const std::string& name, const char*& valueBegin,
+                                  bool caseSensitive = true);
+
+    // Find several properties in one scan of a raw buffer. valueBegins[i] is set like valueBegin of
+    // findPropertyValue(data, length, names[i], ...) would be, nullptr if names[i] is not found.
+    // The scan stops as soon as every name has been found. Returns the number of names found.
+    static size_t findPropertyValues(const char* data, size_t length, const std::string* names, size_t count,
+                                     const char** valueBegins, bool caseSensitive = true);
+
 private:
+    // A record split between feeds lives in m_buffer[m_readPos, m_buffer.size()); complete
+    // records are tokenized directly in the caller's data. Consuming a token only advances
+    // m_readPos; the unconsumed tail is moved to the front (compacted) lazily.
     std::vector<char> m_buffer;
+    size_t m_readPos{0};
+    size_t m_maxBufferSize{0};
 
-    std::string m_propertyName;
-    std::string m_propertyValue;
-    std::string m_propertyMatch;
+    // Parsing results. The views refer either into the input (m_buffer) or to the storage strings
+    // below, which hold rewritten parts; the string getters copy a view into its storage on demand.
+    mutable std::string_view m_propertyNameView;
+    mutable std::string_view m_propertyValueView;
+    mutable std::string_view m_propertyMatchView;
+    mutable std::string m_propertyName;
+    mutable std::string m_propertyValue;
+    mutable std::string m_propertyMatch;
 
     bool m_isValid{false};
     bool m_caseInsensitive{false};
 
-    // Extract next token from buffer according to README rules.
-    // Returns true if a token boundary was found or buffer is full; false if need more data.
-    bool extractNextToken(std::string& token);
+    PropertyNameTable* m_nameTable{nullptr};
+    uint32_t m_propertyNameId{PropertyNameTable::npos};
+    uint64_t m_propertyNameHash{0};
+
+    // Present in every build so that the layout does not depend on PROPERTY_PARSER_STATS.
+    PropertyParserStats m_stats;
+
+    // Batch delivery. Views into the fed data are kept as they are; everything else (rewritten
+    // tokens, records completed in m_buffer) is copied into m_batchText and resolved at the end.
+    struct BatchField {
+        const char* input; // points into the fed data, or nullptr for m_batchText
+        size_t offset;     // offset in m_batchText when input is nullptr
+        size_t size;
+    };
+    struct BatchEntry {
+        BatchField name;
+        BatchField value;
+        BatchField match;
+        bool valid;
+        size_t offset;
+        uint32_t nameId;
+    };
+    std::vector<BatchEntry> m_batchEntries;
+    std::vector<PropertyRecord> m_batch;
+    std::string m_batchText;
+
+    // Tokenizer state of the token being extracted. It survives between feeds, so a token
+    // that arrives in fragments is resumed at m_scanPos (relative to m_readPos), not rescanned.
+    // While the token is a contiguous run of input bytes it is tracked as [m_tokenBegin, m_tokenEnd);
+    // it is copied into m_token only once a byte in the middle has to be skipped.
+    std::string m_token;
+    std::string_view m_tokenView; // the extracted token
+    size_t m_tokenBegin{0};
+    size_t m_tokenEnd{0};
+    bool m_tokenContiguous{true};
+    size_t m_scanPos{0};
+    bool m_tokenStarted{false}; // leading separators were skipped
+    bool m_inQuotes{false};
+    bool m_escape{false};
+    bool m_inLineComment{false};  // '#'
+    bool m_inBlockComment{false}; // /* ... */
+    bool m_endOfInput{false};     // set by finish(): the buffered record cannot grow anymore
+    size_t m_tokenStart{0};       // first byte of the token (after separators) in the window it started in
+    size_t m_recordOffset{0};     // offset of the last parsed record in the fed data (0 if it was buffered)
+
+    // Extract next token from the window [buf, buf + size) that starts at the current token
+    // start; the window is full when it holds m_maxBufferSize bytes or the input has ended. Returns true if a token
+    // boundary was found or the window is full, with the token in m_tokenView and the number of
+    // bytes it took (separators and delimiter included) in consumed. Returns false if more data
+    // is needed; consumed is then non-zero only if the window held nothing but separators.
+    bool extractNextToken(const char* buf, size_t size, size_t& consumed);
+
+    // Position of the tokenizer inside the data of one feed.
+    struct FeedPosition {
+        size_t processed{0}; // bytes consumed or buffered
+        size_t fillEnd{0};   // end of the current fill (see parseNextFrom)
+    };
+
+    FeedPosition beginFeed(size_t length);
+
+    // Parse the next token of a feed, continuing a buffered record first. Returns false once
+    // the data is exhausted (the trailing partial record is then buffered).
+    bool parseNextFrom(const char* data, size_t length, FeedPosition& position);
+
+    // Start a new fill at position.processed once the current one is used up.
+    void refill(FeedPosition& position, size_t length) const;
+
+    // End of a fill that starts at processed.
+    size_t fillEndFrom(size_t processed, size_t length) const;
+
+    // One step of finish(): parse the next record of the buffered rest as the end of the input.
+    // Returns false once nothing is left; the tokenizer is reset for new input then.
+    bool finishStep();
+
+    // The last step produced a record that is delivered (valid, or an invalid record with a match).
+    bool hasRecord() const { return m_isValid || !m_propertyMatchView.empty(); }
+
+    // Current result as a record; the views are valid until the next step.
+    PropertyRecord currentRecord() const {
+        return {m_propertyNameView, m_propertyValueView, m_propertyMatchView, m_isValid, m_recordOffset, m_propertyNameId};
+    }
+
+    // Exposes the stepping functions to PropertyRange, PropertyDiff and PropertyAsyncParser.
+    friend class PropertyParserSteps;
+
+    // Positions of one parseParallelStep() call: its start (the tokenizer state between records)
+    // and its end, each with the end of the fill it was in.
+    struct StepSpan {
+        size_t begin;
+        size_t fillEnd;
+        size_t end;
+        size_t nextFillEnd;
+    };
+
+    // Whether a step tokenized ahead, by another parser or in an earlier version of the input, can be
+    // taken over at position, which is where the step begins. The step's positions are moved by
+    // offset (added modulo 2^64, so it may move them back). On success position is moved past the step.
+    bool reuseStep(const StepSpan& step, size_t offset, const char* data, size_t length, FeedPosition& position) const;
+
+    // Parallel parsing. A step is one parseParallelStep() call of a worker and the record it produced, if any.
+    struct ParallelStep : StepSpan {
+        size_t entry; // index in m_batchEntries, or npos if no record was delivered
+    };
+    std::vector<ParallelStep> m_parallelSteps;
+
+    // parseNextFrom() for a complete input: the trailing record is parsed as finish() does.
+    bool parseParallelStep(const char* data, size_t length, FeedPosition& position);
+
+    // Worker: speculatively parse the steps that start in [begin, end), starting with a new fill at begin.
+    void parseParallelChunk(const char* data, size_t length, size_t begin, size_t end);
+
+    // Batch entry for record; fields outside data are copied into m_batchText.
+    BatchEntry makeBatchEntry(const PropertyRecord& record, const char* data, size_t length);
+
+    // Record of a batch entry made by this parser.
+    PropertyRecord resolveBatchEntry(const BatchEntry& entry) const;
+
+    void appendTokenBytes(const char* buf, size_t pos, size_t count);
+
+    bool parseToken(std::string_view token);
+
+    // Parse the extracted token (m_tokenView) into the results.
+    void emitToken();
+
+    BatchField makeBatchField(const char* data, size_t length, std::string_view view);
+    std::string_view resolveBatchField(const BatchField& field) const;
+
+    void setPropertyMatch(std::string_view token);
+    void clearResult();
+    static const std::string& materialize(std::string& storage, std::string_view& view);
+
+    // Number of buffered bytes that were not consumed yet.
+    size_t bufferedSize() const { return m_buffer.size() - m_readPos; }
+
+    void resetTokenizer();
+
+    // Append input to the buffered partial record.
+    void appendBuffered(const char* data, size_t length);
 
-    bool parseToken(const std::string& token);
+    // Move unconsumed bytes to the front of m_buffer so that appending does not grow it.
+    void compactBuffer();
 
     static bool equalsName(const std::string& a, const std::string& b, bool caseSensitive);
 };
@@ -0,0 +1,278 @@
+#include "PropertyParser.h"
+#include "PropertyRange.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Benchmark suite: deterministic generated corpora run through feedAndParse(), PropertyRange, findPropertyValue()
+// and matchesPattern() in both case modes. Every line reports throughput (MB/s), records (or
+// calls) per second and heap allocations per record, counted by the operator new below.
+// Usage: prop_parser_bench [filter] - runs the benchmarks whose name contains filter.
+
+namespace {
+
+size_t g_allocations = 0;
+
+// Results of the measured calls go here, so that they are not optimized away.
+volatile size_t g_sink = 0;
+
+} // namespace
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ---------------- Corpora ----------------
+
+std::string makeShortLines(size_t targetSize) {
+    std::string out;
+    out.reserve(targetSize + 32);
+    for (size_t i = 0; out.size() < targetSize; ++i) {
+        out += "k" + std::to_string(i % 1000) + "=v" + std::to_string(i) + "\n";
+    }
+    return out;
+}
+
+std::string makeQuotedValues(size_t targetSize) {
+    std::mt19937 rng(1);
+    std::string out;
+    out.reserve(targetSize + 512);
+    for (size_t i = 0; out.size() < targetSize; ++i) {
+        out += "Quoted.Key" + std::to_string(i % 1000) + " = \"";
+        const size_t length = 64 + rng() % 192;
+        for (size_t j = 0; j < length; ++j) {
+            const unsigned r = rng() % 32;
+            if (r == 0) {
+                out += "\\\"";
+            } else if (r == 1) {
+                out += "\\\\";
+            } else {
+                out += static_cast<char>('a' + r % 26);
+            }
+        }
+        out += "\"\n";
+    }
+    return out;
+}
+
+std::string makeHeavyComments(size_t targetSize) {
+    std::string out;
+    out.reserve(targetSize + 128);
+    for (size_t i = 0; out.size() < targetSize; ++i) {
+        out += "# comment line " + std::to_string(i) + " describing the next property in detail\n";
+        out += "key" + std::to_string(i % 1000) + " /* inline */ = value" + std::to_string(i) + " # trailing\n";
+    }
+    return out;
+}
+
+std::string toCrlf(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + text.size() / 8);
+    for (const char c : text) {
+        if (c == '\n') {
+            out += '\r';
+        }
+        out += c;
+    }
+    return out;
+}
+
+// ---------------- Harness ----------------
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double seconds;
+    size_t bytes;
+    size_t records;
+    size_t allocations;
+};
+
+void printHeader() {
+    std::printf("%-44s %10s %14s %12s\n", "benchmark", "MB/s", "records/s", "allocs/rec");
+}
+
+void report(const char* name, const Result& result) {
+    const double mbps = result.bytes / (1024.0 * 1024.0) / result.seconds;
+    const double rps = result.records / result.seconds;
+    const double allocs = result.records ? static_cast<double>(result.allocations) / result.records : 0.0;
+    std::printf("%-44s %10.1f %14.0f %12.3f\n", name, mbps, rps, allocs);
+}
+
+template <class F>
+Result measure(size_t bytes, F&& body) {
+    const size_t allocationsBefore = g_allocations;
+    const auto start = Clock::now();
+    const size_t records = body();
+    const auto stop = Clock::now();
+    return {std::chrono::duration<double>(stop - start).count(), bytes, records, g_allocations - allocationsBefore};
+}
+
+void countRecord(void* data, const PropertyParser& parser) {
+    if (parser.isValid()) {
+        ++*static_cast<size_t*>(data);
+    }
+}
+
+Result parseInChunks(const std::string& input, size_t chunk, size_t bufferSize, bool caseInsensitive) {
+    return measure(input.size(), [&] {
+        PropertyParser parser(bufferSize, caseInsensitive);
+        size_t records = 0;
+        for (size_t offset = 0; offset < input.size(); offset += chunk) {
+            const size_t length = std::min(chunk, input.size() - offset);
+            parser.feedAndParse(input.data() + offset, length, countRecord, &records);
+        }
+        parser.finish(countRecord, &records);
+        return records;
+    });
+}
+
+class Suite {
+public:
+    explicit Suite(const char* filter) : m_filter(filter) {}
+
+    bool selected(const std::string& name) const { return !m_filter || name.find(m_filter) != std::string::npos; }
+
+    template <class F>
+    void run(const std::string& name, F&& benchmark) {
+        if (selected(name)) {
+            report(name.c_str(), benchmark());
+        }
+    }
+
+private:
+    const char* m_filter;
+};
+
+void feedAndParseBenchmarks(Suite& suite) {
+    const size_t size = 16 * 1024 * 1024;
+    const std::pair<const char*, std::string> corpora[] = {
+        {"short", makeShortLines(size)},
+        {"quoted", makeQuotedValues(size)},
+        {"comments", makeHeavyComments(size)},
+        {"crlf", toCrlf(makeShortLines(size))},
+    };
+
+    for (const auto& corpus : corpora) {
+        for (const bool caseInsensitive : {false, true}) {
+            const std::string name = std::string("feedAndParse/") + corpus.first + (caseInsensitive ? "/ci" : "/cs");
+            suite.run(name, [&] { return parseInChunks(corpus.second, 64 * 1024, 64 * 1024, caseInsensitive); });
+        }
+    }
+
+    // Pull-based iteration over the whole input, for comparison with the callbacks above.
+    suite.run("PropertyRange/short", [&] {
+        const std::string& input = corpora[0].second;
+        return measure(input.size(), [&] {
+            size_t records = 0;
+            for (const PropertyRecord& record : PropertyRange(input.data(), input.size())) {
+                records += record.valid;
+            }
+            return records;
+        });
+    });
+
+    // Chunk size scaling with the buffer as large as the chunk: consuming a token must be O(1),
+    // so the throughput is expected to stay flat while the chunk size grows.
+    for (size_t chunk = 1024; chunk <= 1024 * 1024; chunk *= 4) {
+        suite.run("feedAndParse/short/chunk=" + std::to_string(chunk),
+                  [&] { return parseInChunks(corpora[0].second, chunk, chunk, false); });
+    }
+
+    // Pathological fragment sizes: every record is split between feeds.
+    const std::string small = makeShortLines(1024 * 1024);
+    for (const size_t fragment : {1, 3, 7}) {
+        suite.run("feedAndParse/short/fragment=" + std::to_string(fragment),
+                  [&] { return parseInChunks(small, fragment, 4096, false); });
+    }
+}
+
+void findPropertyValueBenchmarks(Suite& suite) {
+    const std::string input = makeShortLines(1024 * 1024);
+    // Names spread over the input, and one that is missing (full scan).
+    const std::vector<std::string> names = {"k0", "k250", "k500", "k999", "missing"};
+    const std::vector<std::string> upperNames = {"K0", "K250", "K500", "K999", "MISSING"};
+
+    for (const bool caseSensitive : {true, false}) {
+        const std::vector<std::string>& lookup = caseSensitive ? names : upperNames;
+        suite.run(std::string("findPropertyValue/") + (caseSensitive ? "cs" : "ci"), [&] {
+            const size_t rounds = 20;
+            Result result = measure(0, [&] {
+                size_t found = 0;
+                for (size_t round = 0; round < rounds; ++round) {
+                    for (const std::string& name : lookup) {
+                        const char* valueBegin = nullptr;
+                        found += PropertyParser::findPropertyValue(input.data(), input.size(), name, valueBegin, caseSensitive);
+                    }
+                }
+                g_sink = g_sink + found;
+                return rounds * lookup.size();
+            });
+            // Bytes actually scanned: up to the name, or the whole input for a missing one.
+            size_t scanned = 0;
+            for (const std::string& name : lookup) {
+                const char* valueBegin = nullptr;
+                PropertyParser::findPropertyValue(input.data(), input.size(), name, valueBegin, caseSensitive);
+                scanned += valueBegin ? static_cast<size_t>(valueBegin - input.data()) : input.size();
+            }
+            result.bytes = scanned * rounds;
+            return result;
+        });
+    }
+}
+
+void matchesPatternBenchmarks(Suite& suite) {
+    std::vector<std::string> keys;
+    size_t keyBytes = 0;
+    for (size_t i = 0; i < 10000; ++i) {
+        keys.push_back("com.Example.Module" + std::to_string(i % 97) + ".Test" + std::to_string(i));
+        keyBytes += keys.back().size();
+    }
+    const std::string patterns[] = {"com.example.*", "*.Test1*", "com.*.Module?.*", "org.other.Test"};
+
+    for (const bool caseSensitive : {true, false}) {
+        suite.run(std::string("matchesPattern/") + (caseSensitive ? "cs" : "ci"), [&] {
+            const size_t rounds = 10;
+            return measure(keyBytes * rounds * 4, [&] {
+                size_t matches = 0;
+                for (size_t round = 0; round < rounds; ++round) {
+                    for (const std::string& key : keys) {
+                        for (const std::string& pattern : patterns) {
+                            matches += PropertyParser::matchesPattern(key, pattern, caseSensitive);
+                        }
+                    }
+                }
+                g_sink = g_sink + matches;
+                return rounds * keys.size() * 4;
+            });
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Suite suite(argc > 1 ? argv[1] : nullptr);
+    printHeader();
+    feedAndParseBenchmarks(suite);
+    findPropertyValueBenchmarks(suite);
+    matchesPatternBenchmarks(suite);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef PROPERTY_PARSER_STEPS_H
+#define PROPERTY_PARSER_STEPS_H
+
+#include "PropertyParser.h"
+
+#include <cstddef>
+
+// Internal stepping interface of PropertyParser, for the classes that drive its tokenizer one record
+// at a time instead of through feedAndParse() and finish(): PropertyRange, PropertyDiff and
+// PropertyAsyncParser. It is the only way they reach the parser's internals. Not part of the public API.
+class PropertyParserSteps {
+public:
+    // Position of the tokenizer inside the data of one feed.
+    using FeedPosition = PropertyParser::FeedPosition;
+    // Start and end positions of one parseComplete() step.
+    using StepSpan = PropertyParser::StepSpan;
+
+    // Start feeding length bytes (feedAndParse()).
+    static FeedPosition beginFeed(PropertyParser& parser, size_t length) { return parser.beginFeed(length); }
+
+    // Parse the next record of a feed. Returns false once the data is exhausted; the trailing partial
+    // record is then buffered.
+    static bool parseFed(PropertyParser& parser, const char* data, size_t length, FeedPosition& position) {
+        return parser.parseNextFrom(data, length, position);
+    }
+
+    // Parse the next record of a complete input; the trailing record ends with it. Call refill() first.
+    static bool parseComplete(PropertyParser& parser, const char* data, size_t length, FeedPosition& position) {
+        return parser.parseParallelStep(data, length, position);
+    }
+
+    // One step of finish(). Returns false once nothing is left.
+    static bool finish(PropertyParser& parser) { return parser.finishStep(); }
+
+    // Start a new fill at position.processed once the current one is used up.
+    static void refill(const PropertyParser& parser, FeedPosition& position, size_t length) { parser.refill(position, length); }
+
+    // Take over a step tokenized ahead (see PropertyParser::reuseStep()).
+    static bool reuseStep(const PropertyParser& parser, const StepSpan& step, size_t offset, const char* data, size_t length,
+                          FeedPosition& position) {
+        return parser.reuseStep(step, offset, data, length, position);
+    }
+
+    // The last step produced a record that feedAndParse() would deliver, and that record.
+    static bool hasRecord(const PropertyParser& parser) { return parser.hasRecord(); }
+    static PropertyRecord currentRecord(const PropertyParser& parser) { return parser.currentRecord(); }
+
+    // Drop the result of the last step, as feedAndParse() does after delivering it.
+    static void clearResult(PropertyParser& parser) { parser.clearResult(); }
+};
+
+#endif // PROPERTY_PARSER_STEPS_H
@@ -1,6 +1,11 @@
+#include "MappedFile.h"
 #include "PropertyParser.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <mutex>
+#include <random>
 #include <vector>
 
 // Structure for callback invocations data
@@ -350,6 +355,24 @@ TEST(PropertyParserTest, FindPropertyValueNotFound) {
     EXPECT_EQ(valueBegin, nullptr);
 }
 
+TEST(PropertyParserTest, FindPropertyValuesOneScan) {
+    const char* src = "a=1\nName = 2;c=3\nname=4\n";
+    const std::string names[] = {"c", "NAME", "missing", "a", "c"};
+    const char* valueBegins[5];
+
+    EXPECT_EQ(PropertyParser::findPropertyValues(src, std::strlen(src), names, 5, valueBegins, false), 4u);
+    for (size_t i = 0; i < 5; ++i) {
+        const char* expected = nullptr;
+        PropertyParser::findPropertyValue(src, std::strlen(src), names[i], expected, false);
+        EXPECT_EQ(valueBegins[i], expected) << names[i];
+    }
+    EXPECT_EQ(std::string(valueBegins[1], 1), "2");
+    EXPECT_EQ(valueBegins[2], nullptr);
+
+    EXPECT_EQ(PropertyParser::findPropertyValues(src, std::strlen(src), names, 5, valueBegins, true), 3u);
+    EXPECT_EQ(valueBegins[1], nullptr);
+}
+
 // ---------------- Big input / small buffer ----------------
 
 TEST(PropertyParserTest, FeedAndParseLargeData) {
@@ -402,3 +425,373 @@ TEST(PropertyParserTest, FeedAndParseSingleLargeInvalidLine) {
     EXPECT_EQ(callbackData.propertyMatches[0], "this_is_a_");
     EXPECT_FALSE(callbackData.isValidFlags[0]);
 }
+
+// Partial tokens left at the end of the buffer must survive compaction when more data is appended.
+TEST(PropertyParserTest, FeedAndParsePartialTokensAcrossCompaction) {
+    CallbackData callbackData;
+    PropertyParser parser(16, false);
+
+    std::string input;
+    for (int i = 0; i < 50; ++i) {
+        input += "key" + std::to_string(i) + "=v" + std::to_string(i) + "\n";
+    }
+
+    // Odd chunk size so that tokens are split between feeds at varying positions.
+    for (size_t offset = 0; offset < input.size(); offset += 7) {
+        parser.feedAndParse(input.data() + offset, std::min<size_t>(7, input.size() - offset), testCallback, &callbackData);
+    }
+
+    ASSERT_EQ(callbackData.callCount, 50);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_TRUE(callbackData.isValidFlags[i]);
+        EXPECT_EQ(callbackData.propertyNames[i], "key" + std::to_string(i));
+        EXPECT_EQ(callbackData.propertyValues[i], "v" + std::to_string(i));
+    }
+}
+
+// A token arriving one byte at a time is resumed where the previous feed stopped,
+// including quotes, escapes, block comments and CRLF split between feeds.
+TEST(PropertyParserTest, FeedAndParseByteByByteResumesTokenizerState) {
+    CallbackData callbackData;
+    PropertyParser parser(1024, false);
+
+    const std::string src = "s=\"a \\\"quoted\\\" value\"\r\n/* block\ncomment */b=2\\\r\n3\r\nc=4;";
+    for (char c : src) {
+        parser.feedAndParse(&c, 1, testCallback, &callbackData);
+    }
+
+    ASSERT_EQ(callbackData.callCount, 3);
+    EXPECT_EQ(callbackData.propertyNames[0], "s");
+    EXPECT_EQ(callbackData.propertyValues[0], "a \"quoted\" value");
+    EXPECT_EQ(callbackData.propertyNames[1], "b");
+    EXPECT_EQ(callbackData.propertyValues[1], "23");
+    EXPECT_EQ(callbackData.propertyNames[2], "c");
+    EXPECT_EQ(callbackData.propertyValues[2], "4");
+}
+
+// ---------------- Zero-copy views ----------------
+
+struct ViewData {
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    std::vector<std::string> matches;
+};
+
+static void viewCallback(void* data, const PropertyParser& parser) {
+    auto* viewData = static_cast<ViewData*>(data);
+    viewData->names.emplace_back(parser.getPropertyNameView());
+    viewData->values.emplace_back(parser.getPropertyValueView());
+    viewData->matches.emplace_back(parser.getPropertyMatchView());
+}
+
+TEST(PropertyParserTest, ViewsMatchStringGetters) {
+    ViewData viewData;
+    PropertyParser parser(1024, true);
+
+    // plain, quoted, escaped, comment + whitespace, case folding and invalid tokens
+    const char* src = "a=1\nq=\"x y\"\ne=\"x\\\"y\"\n k /*c*/ = v \nName=Value\nNoEquals\n";
+    parser.feedAndParse(src, std::strlen(src), viewCallback, &viewData);
+
+    ASSERT_EQ(viewData.names.size(), 6u);
+    EXPECT_EQ(viewData.names[0], "a");
+    EXPECT_EQ(viewData.values[0], "1");
+    EXPECT_EQ(viewData.names[1], "q");
+    EXPECT_EQ(viewData.values[1], "x y");
+    EXPECT_EQ(viewData.values[2], "x\"y");
+    EXPECT_EQ(viewData.names[3], "k");
+    EXPECT_EQ(viewData.values[3], "v");
+    EXPECT_EQ(viewData.names[4], "name");
+    EXPECT_EQ(viewData.values[4], "Value");
+    EXPECT_EQ(viewData.names[5], "");
+    EXPECT_EQ(viewData.matches[5], "noequals");
+}
+
+// ---------------- Direct parsing from the caller's data ----------------
+
+struct PointerRangeData {
+    const char* begin;
+    const char* end;
+    int inside;
+    int total;
+};
+
+static void pointerRangeCallback(void* data, const PropertyParser& parser) {
+    auto* range = static_cast<PointerRangeData*>(data);
+    const char* name = parser.getPropertyNameView().data();
+    ++range->total;
+    if (name >= range->begin && name < range->end) {
+        ++range->inside;
+    }
+}
+
+TEST(PropertyParserTest, CompleteRecordsAreParsedInPlace) {
+    PropertyParser parser(1024, false);
+
+    const std::string src = "a=1\nb=2\nc=3\npartial=";
+    PointerRangeData range{src.data(), src.data() + src.size(), 0, 0};
+    parser.feedAndParse(src.data(), src.size(), pointerRangeCallback, &range);
+
+    // complete records point into the caller's data, the partial record waits for more input
+    EXPECT_EQ(range.total, 3);
+    EXPECT_EQ(range.inside, 3);
+
+    const std::string rest = "4\nd=5\n";
+    PointerRangeData restRange{rest.data(), rest.data() + rest.size(), 0, 0};
+    parser.feedAndParse(rest.data(), rest.size(), pointerRangeCallback, &restRange);
+
+    // "partial=4" was completed in the internal buffer, "d=5" is parsed in place again
+    EXPECT_EQ(restRange.total, 2);
+    EXPECT_EQ(restRange.inside, 1);
+}
+
+// ---------------- Batch delivery ----------------
+
+struct BatchData {
+    int calls = 0;
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    std::vector<std::string> matches;
+    std::vector<bool> validFlags;
+    std::vector<size_t> offsets;
+};
+
+static void batchCallback(void* data, const PropertyRecord* records, size_t count) {
+    auto* batchData = static_cast<BatchData*>(data);
+    ++batchData->calls;
+    for (size_t i = 0; i < count; ++i) {
+        batchData->names.emplace_back(records[i].name);
+        batchData->values.emplace_back(records[i].value);
+        batchData->matches.emplace_back(records[i].match);
+        batchData->validFlags.push_back(records[i].valid);
+        batchData->offsets.push_back(records[i].offset);
+    }
+}
+
+TEST(PropertyParserTest, FeedAndParseBatchDeliversAllRecordsOnce) {
+    BatchData batchData;
+    PropertyParser parser(1024, true);
+
+    const char* src = "A=1\ns=\"x\\\"y\"\ninvalid\nb = 2\n";
+    parser.feedAndParseBatch(src, std::strlen(src), batchCallback, &batchData);
+
+    EXPECT_EQ(batchData.calls, 1);
+    ASSERT_EQ(batchData.names.size(), 4u);
+    EXPECT_EQ(batchData.names[0], "a");
+    EXPECT_EQ(batchData.values[0], "1");
+    EXPECT_EQ(batchData.names[1], "s");
+    EXPECT_EQ(batchData.values[1], "x\"y");
+    EXPECT_FALSE(batchData.validFlags[2]);
+    EXPECT_EQ(batchData.matches[2], "invalid");
+    EXPECT_EQ(batchData.names[3], "b");
+    EXPECT_EQ(batchData.values[3], "2");
+    EXPECT_EQ(batchData.offsets, (std::vector<size_t>{0, 4, 13, 21}));
+}
+
+TEST(PropertyParserTest, FeedAndParseBatchKeepsRecordSplitBetweenFeeds) {
+    BatchData batchData;
+    PropertyParser parser(1024, false);
+
+    parser.feedAndParseBatch("a=1\nb=", 6, batchCallback, &batchData);
+    parser.feedAndParseBatch("2\n", 2, batchCallback, &batchData);
+    parser.feedAndParseBatch("", 0, batchCallback, &batchData);
+
+    EXPECT_EQ(batchData.calls, 2);
+    ASSERT_EQ(batchData.names.size(), 2u);
+    EXPECT_EQ(batchData.names[1], "b");
+    EXPECT_EQ(batchData.values[1], "2");
+}
+
+// ---------------- Parallel parsing ----------------
+
+static std::mutex batchMutex;
+
+static void lockedBatchCallback(void* data, const PropertyRecord* records, size_t count) {
+    std::lock_guard<std::mutex> lock(batchMutex);
+    batchCallback(data, records, count);
+}
+
+static void collectBatchCallback(void* data, const PropertyParser& parser) {
+    const PropertyRecord record{parser.getPropertyNameView(), parser.getPropertyValueView(),
+                                parser.getPropertyMatchView(), parser.isValid(), 0};
+    batchCallback(data, &record, 1);
+}
+
+TEST(PropertyParserTest, ParseParallelStitchesChunks) {
+    // the chunk starts fall after an unterminated quote, inside a block comment and a continued line
+    const std::string src = "a=\"1\n2\n3\"\nb=/*x\ny\nz*/2\nc=3\\\n4\\\n5\nd=4";
+    BatchData batchData;
+    PropertyParser parser(1024, false);
+    parser.parseParallel(src.data(), src.size(), batchCallback, &batchData, 8);
+
+    ASSERT_EQ(batchData.names.size(), 6u);
+    EXPECT_FALSE(batchData.validFlags[0]);
+    EXPECT_EQ(batchData.matches[0], "a=\"1");
+    EXPECT_EQ(batchData.matches[2], "3\"");
+    EXPECT_EQ(batchData.names[3], "b");
+    EXPECT_EQ(batchData.values[3], "2");
+    EXPECT_EQ(batchData.names[4], "c");
+    EXPECT_EQ(batchData.values[4], "345");
+    EXPECT_EQ(batchData.offsets[4], src.find("c="));
+    EXPECT_EQ(batchData.names[5], "d");
+    EXPECT_EQ(batchData.values[5], "4");
+    EXPECT_EQ(batchData.offsets[5], src.size() - 3);
+}
+
+TEST(PropertyParserTest, ParseParallelSameAsSequential) {
+    const char alphabet[] = {'a', 'b', 'A', '=', ' ', '\n', '\n', '\r', ';', '"', '\\', '#', '/', '*'};
+    std::mt19937 rng(42);
+
+    for (int round = 0; round < 3000; ++round) {
+        std::string src(rng() % 160, ' ');
+        for (char& c : src) {
+            c = alphabet[rng() % sizeof(alphabet)];
+        }
+        const size_t bufferSize = 1 + rng() % 32;
+        const bool caseInsensitive = rng() % 2 == 0;
+        const size_t threads = 1 + rng() % 8;
+
+        BatchData expected;
+        PropertyParser sequential(bufferSize, caseInsensitive);
+        sequential.feedAndParseBatch(src.data(), src.size(), batchCallback, &expected);
+        const size_t inPlace = expected.offsets.size();
+        sequential.finish(collectBatchCallback, &expected);
+
+        BatchData ordered;
+        PropertyParser parser(bufferSize, caseInsensitive);
+        parser.parseParallel(src.data(), src.size(), batchCallback, &ordered, threads);
+        ASSERT_EQ(ordered.names, expected.names) << src;
+        ASSERT_EQ(ordered.values, expected.values) << src;
+        ASSERT_EQ(ordered.matches, expected.matches) << src;
+        ASSERT_EQ(ordered.validFlags, expected.validFlags) << src;
+        ASSERT_TRUE(std::equal(expected.offsets.begin(), expected.offsets.begin() + inPlace, ordered.offsets.begin())) << src;
+
+        // unordered batches carry the same records
+        BatchData unordered;
+        parser.parseParallel(src.data(), src.size(), lockedBatchCallback, &unordered, threads, false);
+        std::vector<std::pair<size_t, std::string>> sorted;
+        for (size_t i = 0; i < unordered.names.size(); ++i) {
+            sorted.emplace_back(unordered.offsets[i], unordered.names[i] + "=" + unordered.values[i] + "|" + unordered.matches[i]);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_EQ(sorted.size(), expected.names.size()) << src;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            ASSERT_EQ(sorted[i].second, expected.names[i] + "=" + expected.values[i] + "|" + expected.matches[i]) << src;
+        }
+    }
+}
+
+// ---------------- Functor callbacks ----------------
+
+TEST(PropertyParserTest, FeedAndParseWithLambda) {
+    PropertyParser parser(1024, false);
+
+    std::vector<std::string> names;
+    std::vector<std::string> matches;
+    const char* src = "a=1\ninvalid\nb=2\n";
+    parser.feedAndParse(src, std::strlen(src), [&](const PropertyParser& p) {
+        if (p.isValid()) {
+            names.emplace_back(p.getPropertyNameView());
+        } else {
+            matches.emplace_back(p.getPropertyMatchView());
+        }
+    });
+
+    ASSERT_EQ(names.size(), 2u);
+    EXPECT_EQ(names[0], "a");
+    EXPECT_EQ(names[1], "b");
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0], "invalid");
+
+    // the C-style overload is still selected for function pointers and nullptr
+    CallbackData callbackData;
+    parser.feedAndParse("c=3\n", 4, testCallback, &callbackData);
+    parser.feedAndParse("d=4\n", 4, nullptr);
+    EXPECT_EQ(callbackData.callCount, 1);
+}
+
+// ---------------- Statistics ----------------
+
+TEST(PropertyParserTest, Stats) {
+    PropertyParser parser(8, false);
+    parser.feedAndParse("a=1\nbad\nlongvalue=", 19);
+    parser.feedAndParse("2\n", 2);
+
+    const PropertyParserStats& stats = parser.getStats();
+#ifdef PROPERTY_PARSER_STATS
+    EXPECT_EQ(stats.bytesFed, 21u);
+    EXPECT_EQ(stats.tokens, 4u); // "longvalue=2" is cut at 8 bytes: "longvalu" and "e=2"
+    EXPECT_EQ(stats.validRecords, 2u);
+    EXPECT_EQ(stats.invalidRecords, 2u);
+    EXPECT_EQ(stats.forcedSplits, 1u);
+    EXPECT_GT(stats.bytesBuffered, 0u);
+    EXPECT_LE(stats.peakBufferSize, 8u);
+    EXPECT_GE(stats.bytesScanned, 21u);
+#else
+    EXPECT_EQ(stats.bytesFed, 0u);
+    EXPECT_EQ(stats.tokens, 0u);
+#endif
+
+    parser.resetStats();
+    EXPECT_EQ(parser.getStats().bytesFed, 0u);
+}
+
+// ---------------- Files ----------------
+
+static std::string writeTempFile(const char* name, const std::string& contents) {
+    const std::string path = ::testing::TempDir() + name;
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file) {
+        std::fwrite(contents.data(), 1, contents.size(), file);
+        std::fclose(file);
+    }
+    return path;
+}
+
+TEST(PropertyParserTest, FinishDeliversTrailingRecord) {
+    CallbackData callbackData;
+    PropertyParser parser(1024, false);
+
+    const char* src = "a=1\nb=2";
+    parser.feedAndParse(src, std::strlen(src), testCallback, &callbackData);
+    EXPECT_EQ(callbackData.callCount, 1);
+
+    parser.finish(testCallback, &callbackData);
+    ASSERT_EQ(callbackData.callCount, 2);
+    EXPECT_EQ(callbackData.propertyNames[1], "b");
+    EXPECT_EQ(callbackData.propertyValues[1], "2");
+
+    // nothing left to deliver
+    parser.finish(testCallback, &callbackData);
+    EXPECT_EQ(callbackData.callCount, 2);
+}
+
+TEST(PropertyParserTest, ParseFile) {
+    const std::string contents = "a=1\n# comment\nq=\"x;y\"\r\nlong=" + std::string(3000, 'v') + "\nlast=end";
+    const std::string path = writeTempFile("prop_parser_parse_file.properties", contents);
+
+    CallbackData expected;
+    PropertyParser reference(512, false);
+    reference.feedAndParse(contents.data(), contents.size(), testCallback, &expected);
+    reference.feedAndParse("\n", 1, testCallback, &expected);
+
+    CallbackData callbackData;
+    PropertyParser parser(512, false);
+    parser.feedAndParse("stale=", 6);
+    ASSERT_TRUE(parser.parseFile(path, testCallback, &callbackData));
+    EXPECT_EQ(callbackData.propertyNames, expected.propertyNames);
+    EXPECT_EQ(callbackData.propertyValues, expected.propertyValues);
+    EXPECT_EQ(callbackData.propertyMatches, expected.propertyMatches);
+    ASSERT_FALSE(callbackData.propertyNames.empty());
+    EXPECT_EQ(callbackData.propertyNames.back(), "last");
+
+    MappedFile file(path);
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_EQ(file.size(), contents.size());
+    const char* valueBegin = nullptr;
+    ASSERT_TRUE(PropertyParser::findPropertyValue(file, "q", valueBegin));
+    EXPECT_EQ(valueBegin, file.data() + contents.find('"'));
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(parser.parseFile(path, testCallback, &callbackData));
+    EXPECT_FALSE(file.open(path));
+}
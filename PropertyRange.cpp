@@ -0,0 +1,29 @@
+#include "PropertyRange.h"
+
+PropertyRange::PropertyRange(const char* data, size_t length, bool caseInsensitive, size_t maxBufferSize)
+    : m_data(data), m_length(data ? length : 0), m_parser(maxBufferSize, caseInsensitive) {}
+
+PropertyRange::iterator PropertyRange::begin() {
+    if (!m_started) {
+        m_started = true;
+        m_done = !advance();
+    }
+    return iterator(m_done ? nullptr : this);
+}
+
+bool PropertyRange::advance() {
+    // The steps of parseParallel(), run on demand.
+    while (!m_done && m_position.processed < m_length) {
+        PropertyParserSteps::refill(m_parser, m_position, m_length);
+        if (!PropertyParserSteps::parseComplete(m_parser, m_data, m_length, m_position)) {
+            break;
+        }
+        if (PropertyParserSteps::hasRecord(m_parser)) {
+            m_record = PropertyParserSteps::currentRecord(m_parser);
+            return true;
+        }
+    }
+    m_done = true;
+    m_record = PropertyRecord{};
+    return false;
+}
@@ -0,0 +1,74 @@
+#ifndef PROPERTY_RANGE_H
+#define PROPERTY_RANGE_H
+
+#include "PropertyParserSteps.h"
+
+#include <cstddef>
+#include <iterator>
+
+// Pull-based iteration over a complete input:
+//     for (const PropertyRecord& record : PropertyRange(data, length)) { ... }
+// Records are the ones feedAndParse() and finish() would deliver, produced one at a time as the
+// loop advances: nothing past the current record is tokenized, so breaking out of the loop stops
+// the parse. Records are tokenized in place in data (only a trailing record that ends without a
+// delimiter is copied); their views are valid until the iterator is advanced.
+// The range is single-pass: begin() continues where the previous iteration stopped.
+class PropertyRange {
+public:
+    static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+    PropertyRange(const char* data, size_t length, bool caseInsensitive = false, size_t maxBufferSize = kDefaultBufferSize);
+
+    PropertyRange(const PropertyRange&) = delete;
+    PropertyRange& operator=(const PropertyRange&) = delete;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = PropertyRecord;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const PropertyRecord*;
+        using reference = const PropertyRecord&;
+
+        iterator() = default;
+
+        reference operator*() const { return m_range->m_record; }
+        pointer operator->() const { return &m_range->m_record; }
+
+        iterator& operator++() {
+            if (!m_range->advance()) {
+                m_range = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return m_range == other.m_range; }
+        bool operator!=(const iterator& other) const { return m_range != other.m_range; }
+
+    private:
+        friend class PropertyRange;
+        explicit iterator(PropertyRange* range) : m_range(range) {}
+
+        PropertyRange* m_range{nullptr};
+    };
+
+    iterator begin();
+    iterator end() { return iterator(); }
+
+    // Bytes of the input tokenized so far.
+    size_t consumed() const { return m_position.processed; }
+
+private:
+    const char* m_data;
+    size_t m_length;
+    PropertyParser m_parser;
+    PropertyParserSteps::FeedPosition m_position;
+    PropertyRecord m_record{};
+    bool m_started{false};
+    bool m_done{false};
+
+    // Parse the next record into m_record. Returns false at the end of the input.
+    bool advance();
+};
+
+#endif // PROPERTY_RANGE_H
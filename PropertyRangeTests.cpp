@@ -0,0 +1,91 @@
+#include "PropertyRange.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Record {
+    std::string name;
+    std::string value;
+    std::string match;
+    bool valid;
+
+    bool operator==(const Record& other) const {
+        return name == other.name && value == other.value && match == other.match && valid == other.valid;
+    }
+};
+
+void collect(void* data, const PropertyParser& parser) {
+    static_cast<std::vector<Record>*>(data)->push_back(
+        {parser.getPropertyName(), parser.getPropertyValue(), parser.getPropertyMatch(), parser.isValid()});
+}
+
+} // namespace
+
+TEST(PropertyRangeTest, IteratesRecords) {
+    const std::string input = "a = 1\n# comment\nb=\"x;y\";bad\r\nC=3";
+    std::vector<Record> records;
+    std::vector<size_t> offsets;
+    for (const PropertyRecord& record : PropertyRange(input.data(), input.size(), true)) {
+        records.push_back({std::string(record.name), std::string(record.value), std::string(record.match), record.valid});
+        offsets.push_back(record.offset);
+    }
+    const std::vector<Record> expected = {{"a", "1", "", true}, {"b", "x;y", "", true}, {"", "", "bad", false}, {"c", "3", "", true}};
+    EXPECT_EQ(records, expected);
+    EXPECT_EQ(offsets, (std::vector<size_t>{0, 16, 24, 29}));
+
+    size_t count = 0;
+    for (const PropertyRecord& record : PropertyRange(nullptr, 0)) {
+        (void)record;
+        ++count;
+    }
+    EXPECT_EQ(count, 0u);
+}
+
+TEST(PropertyRangeTest, StopsWhenTheLoopBreaks) {
+    std::string input = "first=1\nsecond=2\n";
+    input.append(1000, 'x');
+    PropertyRange range(input.data(), input.size());
+    for (const PropertyRecord& record : range) {
+        if (record.name == "second") {
+            break;
+        }
+    }
+    EXPECT_EQ(range.consumed(), 17u);
+
+    // Single pass: iteration continues where it stopped.
+    auto it = range.begin();
+    ASSERT_NE(it, range.end());
+    EXPECT_EQ(it->name, "second");
+    ++it;
+    ASSERT_NE(it, range.end());
+    EXPECT_FALSE(it->valid);
+    ++it;
+    EXPECT_EQ(it, range.end());
+}
+
+TEST(PropertyRangeTest, MatchesFeedAndParse) {
+    const char alphabet[] = "ab=  \n\n\r;\"\\#/*A";
+    std::mt19937 rng(5);
+    for (int round = 0; round < 2000; ++round) {
+        std::string input(rng() % 120, ' ');
+        for (char& c : input) {
+            c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+        const size_t bufferSize = 1 + rng() % 40;
+        const bool caseInsensitive = rng() % 2;
+
+        std::vector<Record> expected;
+        PropertyParser parser(bufferSize, caseInsensitive);
+        parser.feedAndParse(input.data(), input.size(), collect, &expected);
+        parser.finish(collect, &expected);
+
+        std::vector<Record> records;
+        for (const PropertyRecord& record : PropertyRange(input.data(), input.size(), caseInsensitive, bufferSize)) {
+            records.push_back({std::string(record.name), std::string(record.value), std::string(record.match), record.valid});
+        }
+        ASSERT_EQ(records, expected) << input;
+    }
+}
@@ -0,0 +1,219 @@
+#include "PropertyRawScanner.h"
+
+#include "CharClassifier.h"
+
+namespace {
+
+inline bool isSpaceOrTab(char c) { return c == ' ' || c == '\t'; }
+
+} // namespace
+
+PropertyRawScanner::PropertyRawScanner(const char* data, size_t length) : m_data(data), m_length(data ? length : 0) {}
+
+bool PropertyRawScanner::next() {
+    const char* data = m_data;
+    const size_t length = m_length;
+
+    auto isDelimiter = [](char c) { return c == '\n' || c == ';'; };
+
+    bool inQuotes = false;
+    bool escape = false;
+    bool inLineComment = false;
+    bool inBlockComment = false;
+
+    size_t tokenStart = 0;
+
+    auto skipSeparators = [&](size_t& pos) {
+        while (pos < length && (data[pos] == '\n' || data[pos] == '\r' || data[pos] == ';')) {
+            ++pos;
+        }
+    };
+
+    size_t pos = m_pos;
+    while (pos < length) {
+        skipSeparators(pos);
+        if (pos >= length) {
+            break;
+        }
+        tokenStart = pos;
+
+        // Find token end (similar rules as tokenizer, but we want raw pointer to value start).
+        inQuotes = false;
+        escape = false;
+        inLineComment = false;
+        inBlockComment = false;
+
+        size_t tokenEnd = pos;
+        for (; tokenEnd < length; ++tokenEnd) {
+            const char c = data[tokenEnd];
+            if (!isSpecialChar(c)) {
+                // Skip ordinary text in bulk; it only ends a pending escape.
+                tokenEnd = static_cast<size_t>(findSpecialChar(data + tokenEnd + 1, data + length) - data) - 1;
+                escape = false;
+                continue;
+            }
+            const char next = (tokenEnd + 1 < length) ? data[tokenEnd + 1] : '\0';
+            const bool isCRLF = (c == '\r' && next == '\n');
+
+            if (inLineComment) {
+                if (c == '\n' || isCRLF) {
+                    break;
+                }
+                continue;
+            }
+            if (inBlockComment) {
+                if (c == '*' && next == '/') {
+                    inBlockComment = false;
+                    ++tokenEnd;
+                }
+                continue;
+            }
+
+            if (!inQuotes) {
+                if (c == '#') {
+                    inLineComment = true;
+                    continue;
+                }
+                if (c == '/' && next == '*') {
+                    inBlockComment = true;
+                    ++tokenEnd;
+                    continue;
+                }
+                if (c == '\\') {
+                    if (next == '\n') {
+                        ++tokenEnd;
+                        continue;
+                    }
+                    if (isCRLF) {
+                        tokenEnd += 1;
+                        continue;
+                    }
+                }
+                if (isDelimiter(c) || isCRLF || c == ';') {
+                    break;
+                }
+                if (c == '"') {
+                    inQuotes = true;
+                }
+                continue;
+            } else {
+                if (escape) {
+                    escape = false;
+                    continue;
+                }
+                if (c == '\\') {
+                    escape = true;
+                    continue;
+                }
+                if (c == '"') {
+                    inQuotes = false;
+                    continue;
+                }
+            }
+        }
+
+        // Now we have [tokenStart, tokenEnd) in original buffer (delimiter at tokenEnd or end).
+        // Find '=' and compare names (ignoring spaces/tabs and comments is hard here; we approximate by skipping spaces/tabs).
+        // We'll scan from tokenStart to tokenEnd to find '=' outside quotes/comments.
+        bool localInQuotes = false;
+        bool localEscape = false;
+        bool localLineComment = false;
+        bool localBlockComment = false;
+
+        size_t eqPos = std::string::npos;
+
+        for (size_t i = tokenStart; i < tokenEnd; ++i) {
+            const char c = data[i];
+            if (!isSpecialChar(c)) {
+                i = static_cast<size_t>(findSpecialChar(data + i + 1, data + tokenEnd) - data) - 1;
+                localEscape = false;
+                continue;
+            }
+            const char next = (i + 1 < tokenEnd) ? data[i + 1] : '\0';
+
+            if (localLineComment) {
+                break;
+            }
+            if (localBlockComment) {
+                if (c == '*' && next == '/') {
+                    localBlockComment = false;
+                    ++i;
+                }
+                continue;
+            }
+
+            if (!localInQuotes) {
+                if (c == '#') {
+                    localLineComment = true;
+                    break;
+                }
+                if (c == '/' && next == '*') {
+                    localBlockComment = true;
+                    ++i;
+                    continue;
+                }
+                if (c == '"') {
+                    localInQuotes = true;
+                    continue;
+                }
+                if (c == '=') {
+                    eqPos = i;
+                    break;
+                }
+            } else {
+                if (localEscape) {
+                    localEscape = false;
+                    continue;
+                }
+                if (c == '\\') {
+                    localEscape = true;
+                    continue;
+                }
+                if (c == '"') {
+                    localInQuotes = false;
+                    continue;
+                }
+            }
+        }
+
+        // Move pos to delimiter / next token start
+        pos = tokenEnd;
+        // Consume CRLF as delimiter
+        if (pos < length && data[pos] == '\r' && (pos + 1 < length) && data[pos + 1] == '\n') {
+            pos += 2;
+        } else if (pos < length && (data[pos] == '\n' || data[pos] == ';')) {
+            pos += 1;
+        }
+
+        if (eqPos != std::string::npos && eqPos > tokenStart) {
+            // Extract name portion: [tokenStart, eqPos)
+            m_name.clear();
+            for (size_t i = tokenStart; i < eqPos; ++i) {
+                const char c = data[i];
+                if (isSpaceOrTab(c)) {
+                    continue;
+                }
+                if (c == '/' && (i + 1 < eqPos) && data[i + 1] == '*') {
+                    // stop on comment start inside key
+                    break;
+                }
+                if (c == '#') {
+                    break;
+                }
+                m_name.push_back(c);
+            }
+
+            // value begin is first non-space/tab after '='
+            size_t vb = eqPos + 1;
+            while (vb < tokenEnd && isSpaceOrTab(data[vb])) {
+                ++vb;
+            }
+            m_valueBegin = data + vb;
+            m_pos = pos;
+            return true;
+        }
+    }
+
+    m_pos = pos;
+    return false;
+}
@@ -0,0 +1,33 @@
+#ifndef PROPERTY_RAW_SCANNER_H
+#define PROPERTY_RAW_SCANNER_H
+
+#include <cstddef>
+#include <string>
+
+// Walks the properties of a complete raw buffer with the rules of PropertyParser::findPropertyValue():
+// for every token that has a name it yields the name (spaces/tabs removed, cut at a comment start)
+// and the address of the first character of the value in the buffer (not trimmed / not unescaped).
+// Shared by the lookups that have to agree with findPropertyValue().
+class PropertyRawScanner {
+public:
+    PropertyRawScanner(const char* data, size_t length);
+
+    // Advance to the next property. Returns false at the end of the buffer.
+    bool next();
+
+    // Name of the current property; valid until the next call to next().
+    const std::string& name() const { return m_name; }
+
+    // First character of the current value in the buffer.
+    const char* valueBegin() const { return m_valueBegin; }
+
+private:
+    const char* m_data;
+    size_t m_length;
+    size_t m_pos{0};
+
+    std::string m_name; // reused between properties
+    const char* m_valueBegin{nullptr};
+};
+
+#endif // PROPERTY_RAW_SCANNER_H
@@ -0,0 +1,238 @@
+#ifndef PROPERTY_SCHEMA_H
+#define PROPERTY_SCHEMA_H
+
+#include "AsciiCase.h"
+#include "PropertyParser.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// A key set known at build time, with a perfect hash computed by the compiler:
+//     static constexpr auto kSchema = makePropertySchema("timeout", "retries", "host");
+//     static_assert(kSchema.isValid() && kSchema.find("retries") == 1);
+// find() rejects a name by its length or by the hash slot, and compares the bytes of a single
+// candidate only to confirm a hit. Keys keep the index they were given. A schema is invalid (and
+// find() always fails) if a key is empty or repeated; check isValid() with static_assert.
+// The driver functions below parse with PropertyParser's grammar and route every known property
+// to its index, so a config loader can switch on it.
+template <size_t N>
+class PropertySchema {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Two-level (hash and displace) perfect hash: the bucket of a key holds the displacement that
+    // moves the keys of that bucket to free slots. With about one key per bucket and twice as many
+    // slots as keys, a small displacement is found for every bucket whatever the key count.
+    static constexpr size_t kSlotCount = [] {
+        size_t count = 2;
+        while (count < N * 2) {
+            count *= 2;
+        }
+        return count;
+    }();
+    static constexpr size_t kBucketCount = [] {
+        size_t count = 1;
+        while (count < N) {
+            count *= 2;
+        }
+        return count;
+    }();
+
+    constexpr explicit PropertySchema(const std::array<std::string_view, N>& keys, bool caseInsensitive = false)
+        : m_keys(keys), m_caseInsensitive(caseInsensitive) {
+        for (size_t i = 0; i < N; ++i) {
+            if (m_keys[i].empty()) {
+                return;
+            }
+            m_minLength = (i == 0 || m_keys[i].size() < m_minLength) ? m_keys[i].size() : m_minLength;
+            m_maxLength = m_keys[i].size() > m_maxLength ? m_keys[i].size() : m_maxLength;
+        }
+        const Table table = buildTable(m_keys, m_caseInsensitive);
+        m_slots = table.slots;
+        m_displacements = table.displacements;
+        m_valid = table.valid;
+    }
+
+    constexpr bool isValid() const { return m_valid; }
+    constexpr bool isCaseInsensitive() const { return m_caseInsensitive; }
+    static constexpr size_t size() { return N; }
+    constexpr std::string_view key(size_t index) const { return m_keys[index]; }
+
+    // Index of name, or npos. In case-insensitive mode name may use any case.
+    constexpr size_t find(std::string_view name) const {
+        if (!m_valid || name.size() < m_minLength || name.size() > m_maxLength) {
+            return npos;
+        }
+        const uint64_t hash = hashKey(name, m_caseInsensitive);
+        const Slot& slot = m_slots[slotOf(hash, m_displacements[bucketOf(hash)])];
+        if (slot.entry == 0 || slot.hash != hash || m_keys[slot.entry - 1].size() != name.size()) {
+            return npos;
+        }
+        return sameKey(m_keys[slot.entry - 1], name) ? slot.entry - 1 : npos;
+    }
+
+private:
+    // Displacements tried per bucket. A bucket of one key misses a free slot with probability
+    // at most 1/2 per try, so the limit is only reached by keys with the same 64-bit hash.
+    static constexpr uint32_t kMaxDisplacement = 1u << 16;
+
+    struct Slot {
+        uint64_t hash{0};
+        // Key index + 1, 0 for a free slot: a zeroed table is empty. (GCC 12 can drop a non-zero member
+        // default in a large array once the same type has been built in a constant expression.)
+        uint32_t entry{0};
+    };
+
+    struct Table {
+        std::array<Slot, kSlotCount> slots{};
+        std::array<uint32_t, kBucketCount> displacements{};
+        bool valid{false};
+    };
+
+    std::array<std::string_view, N> m_keys{};
+    std::array<Slot, kSlotCount> m_slots{};
+    std::array<uint32_t, kBucketCount> m_displacements{};
+    size_t m_minLength{0};
+    size_t m_maxLength{0};
+    bool m_caseInsensitive{false};
+    bool m_valid{false};
+
+    static constexpr uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static constexpr uint64_t hashKey(std::string_view key, bool caseInsensitive) {
+        // Mixed so that every bit depends on all bytes
+        return mix(hashFolded(key, caseInsensitive));
+    }
+
+    static constexpr size_t bucketOf(uint64_t hash) { return static_cast<size_t>(hash >> 32) & (kBucketCount - 1); }
+
+    static constexpr size_t slotOf(uint64_t hash, uint32_t displacement) {
+        return static_cast<size_t>(mix(hash + displacement * 0x9E3779B97F4A7C15ull)) & (kSlotCount - 1);
+    }
+
+    constexpr bool sameKey(std::string_view a, std::string_view b) const {
+        return m_caseInsensitive ? equalsFolded(a, b) : a == b;
+    }
+
+    // Depends on the keys alone; the constructor copies the result in.
+    static constexpr Table buildTable(const std::array<std::string_view, N>& keys, bool caseInsensitive) {
+        Table table;
+        // Keys grouped by bucket (counting sort).
+        std::array<uint64_t, N> hashes{};
+        std::array<size_t, kBucketCount + 1> start{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = hashKey(keys[i], caseInsensitive);
+            ++start[bucketOf(hashes[i]) + 1];
+        }
+        size_t largest = 0;
+        for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            largest = start[bucket + 1] > largest ? start[bucket + 1] : largest;
+            start[bucket + 1] += start[bucket];
+        }
+        std::array<uint32_t, N> order{};
+        std::array<size_t, kBucketCount> filled{};
+        for (size_t i = 0; i < N; ++i) {
+            const size_t bucket = bucketOf(hashes[i]);
+            order[start[bucket] + filled[bucket]++] = static_cast<uint32_t>(i);
+        }
+
+        // The largest buckets are the hardest to place: they go first, into the emptiest table.
+        for (size_t size = largest; size > 0; --size) {
+            for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+                if (start[bucket + 1] - start[bucket] == size && !placeBucket(table, bucket, hashes, order, start[bucket], size)) {
+                    return table;
+                }
+            }
+        }
+        table.valid = true;
+        return table;
+    }
+
+    static constexpr bool placeBucket(Table& table, size_t bucket, const std::array<uint64_t, N>& hashes,
+                                      const std::array<uint32_t, N>& order, size_t first, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (hashes[order[first + i]] == hashes[order[first + j]]) {
+                    // A repeated key (or a full hash collision) cannot be told apart by any displacement.
+                    return false;
+                }
+            }
+        }
+        for (uint32_t displacement = 0; displacement < kMaxDisplacement; ++displacement) {
+            bool fits = true;
+            for (size_t i = 0; i < size && fits; ++i) {
+                const size_t slot = slotOf(hashes[order[first + i]], displacement);
+                fits = table.slots[slot].entry == 0;
+                for (size_t j = 0; j < i && fits; ++j) {
+                    fits = slotOf(hashes[order[first + j]], displacement) != slot;
+                }
+            }
+            if (fits) {
+                for (size_t i = 0; i < size; ++i) {
+                    const uint32_t index = order[first + i];
+                    Slot& slot = table.slots[slotOf(hashes[index], displacement)];
+                    slot.hash = hashes[index];
+                    slot.entry = index + 1;
+                }
+                table.displacements[bucket] = displacement;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <class... Keys>
+constexpr PropertySchema<sizeof...(Keys)> makePropertySchema(const Keys&... keys) {
+    return PropertySchema<sizeof...(Keys)>({std::string_view(keys)...});
+}
+
+template <class... Keys>
+constexpr PropertySchema<sizeof...(Keys)> makeCaseInsensitivePropertySchema(const Keys&... keys) {
+    return PropertySchema<sizeof...(Keys)>({std::string_view(keys)...}, true);
+}
+
+// Feed data to parser and call onProperty(index, value) for every valid property whose name is in
+// schema; value is the parser view, valid while onProperty runs. Other records are skipped.
+template <size_t N, class F>
+void feedAndParseSchema(PropertyParser& parser, const PropertySchema<N>& schema, const char* data, size_t length,
+                        F&& onProperty) {
+    parser.feedAndParse(data, length, [&](const PropertyParser& p) {
+        if (p.isValid()) {
+            const size_t index = schema.find(p.getPropertyNameView());
+            if (index != PropertySchema<N>::npos) {
+                onProperty(index, p.getPropertyValueView());
+            }
+        }
+    });
+}
+
+// PropertyParser::finish() for feedAndParseSchema().
+template <size_t N, class F>
+void finishSchema(PropertyParser& parser, const PropertySchema<N>& schema, F&& onProperty) {
+    struct Context {
+        const PropertySchema<N>& schema;
+        F& onProperty;
+    } context{schema, onProperty};
+    parser.finish(
+        [](void* data, const PropertyParser& p) {
+            Context& c = *static_cast<Context*>(data);
+            if (p.isValid()) {
+                const size_t index = c.schema.find(p.getPropertyNameView());
+                if (index != PropertySchema<N>::npos) {
+                    c.onProperty(index, p.getPropertyValueView());
+                }
+            }
+        },
+        &context);
+}
+
+#endif // PROPERTY_SCHEMA_H
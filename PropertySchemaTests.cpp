@@ -0,0 +1,121 @@
+#include "PropertySchema.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto kSchema = makePropertySchema("timeout", "retries", "host", "port");
+static_assert(kSchema.isValid(), "schema must be valid");
+static_assert(kSchema.find("timeout") == 0 && kSchema.find("port") == 3, "keys keep their index");
+static_assert(kSchema.find("Port") == decltype(kSchema)::npos, "case-sensitive schema");
+static_assert(kSchema.find("") == decltype(kSchema)::npos, "empty name");
+
+constexpr auto kFolded = makeCaseInsensitivePropertySchema("Server.Host", "server.port");
+static_assert(kFolded.find("SERVER.HOST") == 0 && kFolded.find("Server.Port") == 1, "any case");
+
+static_assert(!makePropertySchema("a", "b", "a").isValid(), "repeated key");
+static_assert(!makePropertySchema("a", "").isValid(), "empty key");
+
+// Keys "key.0" .. "key.<N-1>" in static storage, for schemas too large to spell out.
+template <size_t N>
+struct GeneratedKeys {
+    char text[N][12]{};
+    size_t length[N]{};
+
+    constexpr GeneratedKeys() {
+        for (size_t i = 0; i < N; ++i) {
+            char digits[8]{};
+            size_t count = 0;
+            for (size_t value = i; count == 0 || value > 0; value /= 10) {
+                digits[count++] = static_cast<char>('0' + value % 10);
+            }
+            const char prefix[] = "key.";
+            for (size_t j = 0; j < 4; ++j) {
+                text[i][length[i]++] = prefix[j];
+            }
+            while (count > 0) {
+                text[i][length[i]++] = digits[--count];
+            }
+        }
+    }
+};
+
+template <size_t N>
+constexpr GeneratedKeys<N> kGeneratedKeys{};
+
+template <size_t N>
+constexpr std::array<std::string_view, N> generatedKeys() {
+    std::array<std::string_view, N> keys{};
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = std::string_view(kGeneratedKeys<N>.text[i], kGeneratedKeys<N>.length[i]);
+    }
+    return keys;
+}
+
+constexpr PropertySchema<64> kSchema64(generatedKeys<64>());
+static_assert(kSchema64.isValid() && kSchema64.find("key.0") == 0 && kSchema64.find("key.63") == 63, "64 keys");
+static_assert(kSchema64.find("key.64") == decltype(kSchema64)::npos, "64 keys");
+
+constexpr PropertySchema<256> kSchema256(generatedKeys<256>(), true);
+static_assert(kSchema256.isValid() && kSchema256.find("KEY.200") == 200, "256 keys");
+
+template <size_t N>
+void expectGeneratedSchema(bool caseInsensitive) {
+    const PropertySchema<N> schema(generatedKeys<N>(), caseInsensitive);
+    ASSERT_TRUE(schema.isValid()) << N << " keys";
+    for (size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(schema.find("key." + std::to_string(i)), i) << N << " keys";
+    }
+    EXPECT_EQ(schema.find("key." + std::to_string(N)), schema.npos) << N << " keys";
+    EXPECT_EQ(schema.find("KEY.0"), caseInsensitive ? 0 : schema.npos) << N << " keys";
+}
+
+} // namespace
+
+TEST(PropertySchemaTest, FindAtRuntime) {
+    const std::string names[] = {"timeout", "retries", "host", "port"};
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(kSchema.find(names[i]), i);
+        EXPECT_EQ(kSchema.key(i), names[i]);
+    }
+    EXPECT_EQ(kSchema.find("hosts"), kSchema.npos);
+    EXPECT_EQ(kSchema.find("a"), kSchema.npos);
+    EXPECT_EQ(kSchema.find("retriez"), kSchema.npos);
+
+    // Many keys still get a perfect hash.
+    constexpr auto large = makePropertySchema("k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9", "k10", "k11",
+                                              "k12", "k13", "k14", "k15", "k16", "k17", "k18", "k19", "k20", "k21");
+    static_assert(large.isValid(), "schema must be valid");
+    for (size_t i = 0; i < large.size(); ++i) {
+        EXPECT_EQ(large.find("k" + std::to_string(i)), i);
+    }
+    EXPECT_EQ(large.find("k22"), large.npos);
+}
+
+TEST(PropertySchemaTest, LargeKeySets) {
+    expectGeneratedSchema<1>(false);
+    expectGeneratedSchema<64>(false);
+    expectGeneratedSchema<116>(true);
+    expectGeneratedSchema<128>(false);
+    expectGeneratedSchema<152>(false);
+    expectGeneratedSchema<200>(true);
+    expectGeneratedSchema<300>(false);
+    expectGeneratedSchema<1000>(false);
+    expectGeneratedSchema<4096>(true);
+}
+
+TEST(PropertySchemaTest, RoutesRecords) {
+    PropertyParser parser(64);
+    std::vector<std::pair<size_t, std::string>> routed;
+    auto onProperty = [&](size_t index, std::string_view value) { routed.emplace_back(index, std::string(value)); };
+
+    const std::string input = "host = example.org\nunknown=1\nport=8080\nbroken\nretries=3";
+    for (size_t offset = 0; offset < input.size(); offset += 5) {
+        feedAndParseSchema(parser, kSchema, input.data() + offset, std::min<size_t>(5, input.size() - offset), onProperty);
+    }
+    finishSchema(parser, kSchema, onProperty);
+
+    const std::vector<std::pair<size_t, std::string>> expected = {{2, "example.org"}, {3, "8080"}, {1, "3"}};
+    EXPECT_EQ(routed, expected);
+}
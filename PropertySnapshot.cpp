@@ -0,0 +1,244 @@
+#include "PropertySnapshot.h"
+
+#include "AsciiCase.h"
+#include "HashSlots.h"
+#include "PropertyParser.h"
+#include "PropertyStore.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'P', 'R', 'O', 'P', 'S', 'N', 'A', 'P'};
+const uint32_t kByteOrder = 0x01020304;
+
+inline uint64_t alignUp(uint64_t value) { return (value + 7) & ~uint64_t(7); }
+
+} // namespace
+
+uint64_t PropertySnapshot::checksum(const char* data, size_t length) {
+    // FNV-1a, 8 bytes per step
+    uint64_t hash = kFnv1aBasis ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * kFnv1aPrime;
+    }
+    for (; i < length; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * kFnv1aPrime;
+    }
+    return hash;
+}
+
+std::vector<char> PropertySnapshot::compile(const char* data, size_t length, bool caseInsensitive, size_t maxBufferSize) {
+    PropertyStore store;
+    PropertyParser parser(maxBufferSize, caseInsensitive);
+    parser.feedAndParse(data, length, PropertyStore::collect, &store);
+    parser.finish(PropertyStore::collect, &store);
+
+    // Distinct names in source order. The table is sized for every record, so it does not grow and
+    // its slots are written to the image as they are.
+    HashSlots slots(store.size());
+    std::vector<Entry> entries;
+    std::string text;
+    for (size_t i = 0; i < store.size(); ++i) {
+        const std::string_view name = store.name(i);
+        const uint64_t hash = hashFolded(name, caseInsensitive);
+        const size_t slot = slots.probe(hash, [&](uint32_t index) {
+            const Entry& entry = entries[index];
+            return entry.hash == hash && std::string_view(text.data() + entry.offset, entry.nameLength) == name;
+        });
+        if (slots.at(slot) != 0) {
+            continue;
+        }
+
+        const std::string_view value = store.value(i);
+        entries.push_back({hash, text.size(), static_cast<uint32_t>(name.size()), static_cast<uint32_t>(value.size())});
+        text.append(name.data(), name.size());
+        text.append(value.data(), value.size());
+        slots.insert(slot, [&](size_t index) { return entries[index].hash; });
+    }
+    const uint64_t slotCount = slots.slots().size();
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.flags = caseInsensitive ? kFlagCaseInsensitive : 0;
+    header.maxBufferSize = maxBufferSize;
+    header.sourceSize = length;
+    header.sourceChecksum = checksum(data, length);
+    header.count = entries.size();
+    header.slotCount = slotCount;
+    header.slotsOffset = alignUp(sizeof(Header));
+    header.entriesOffset = alignUp(header.slotsOffset + slotCount * sizeof(uint32_t));
+    header.textOffset = header.entriesOffset + entries.size() * sizeof(Entry);
+    header.textSize = text.size();
+
+    std::vector<char> image(header.textOffset + text.size(), 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    std::memcpy(image.data() + header.slotsOffset, slots.slots().data(), slotCount * sizeof(uint32_t));
+    if (!entries.empty()) {
+        std::memcpy(image.data() + header.entriesOffset, entries.data(), entries.size() * sizeof(Entry));
+    }
+    if (!text.empty()) {
+        std::memcpy(image.data() + header.textOffset, text.data(), text.size());
+    }
+    return image;
+}
+
+bool PropertySnapshot::write(const std::vector<char>& image, const std::string& path) {
+    const std::string temporary = path + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    if (std::fclose(file) != 0 || !written) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool PropertySnapshot::compileFile(const std::string& sourcePath, const std::string& snapshotPath, bool caseInsensitive,
+                                   size_t maxBufferSize) {
+    MappedFile source;
+    if (!source.open(sourcePath)) {
+        return false;
+    }
+    return write(compile(source.data(), source.size(), caseInsensitive, maxBufferSize), snapshotPath);
+}
+
+bool PropertySnapshot::attach(const char* data, size_t size) {
+    if (size < sizeof(Header)) {
+        return false;
+    }
+    const Header* header = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion ||
+        header->byteOrder != kByteOrder) {
+        return false;
+    }
+
+    // Every table must lie inside the image.
+    const uint64_t slotCount = header->slotCount;
+    if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || header->count > slotCount / 2 ||
+        header->slotsOffset % 8 != 0 || header->entriesOffset % 8 != 0 || header->slotsOffset < sizeof(Header) ||
+        header->slotsOffset > size || slotCount > (size - header->slotsOffset) / sizeof(uint32_t) ||
+        header->entriesOffset < header->slotsOffset + slotCount * sizeof(uint32_t) || header->entriesOffset > size ||
+        header->count > (size - header->entriesOffset) / sizeof(Entry) ||
+        header->textOffset < header->entriesOffset + header->count * sizeof(Entry) || header->textOffset > size ||
+        header->textSize > size - header->textOffset) {
+        return false;
+    }
+
+    m_header = header;
+    m_slots = reinterpret_cast<const uint32_t*>(data + header->slotsOffset);
+    m_entries = reinterpret_cast<const Entry*>(data + header->entriesOffset);
+    m_text = data + header->textOffset;
+    return true;
+}
+
+bool PropertySnapshot::open(const std::string& path) {
+    close();
+    if (!m_file.open(path, false) || !attach(m_file.data(), m_file.size())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool PropertySnapshot::open(std::vector<char> image) {
+    close();
+    m_image = std::move(image);
+    if (!attach(m_image.data(), m_image.size())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool PropertySnapshot::openOrRebuild(const std::string& sourcePath, const std::string& snapshotPath, bool caseInsensitive,
+                                     size_t maxBufferSize) {
+    MappedFile source;
+    if (!source.open(sourcePath)) {
+        close();
+        return false;
+    }
+
+    if (open(snapshotPath) && isCaseInsensitive() == caseInsensitive && this->maxBufferSize() == maxBufferSize &&
+        matchesSource(source.data(), source.size())) {
+        return true;
+    }
+
+    // Stale or missing: parse the text. The snapshot file is only a cache, so failing to write
+    // it does not fail the call.
+    std::vector<char> image = compile(source.data(), source.size(), caseInsensitive, maxBufferSize);
+    (void)write(image, snapshotPath);
+    return open(std::move(image));
+}
+
+void PropertySnapshot::close() {
+    m_file.close();
+    m_image.clear();
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_entries = nullptr;
+    m_text = nullptr;
+}
+
+bool PropertySnapshot::isCaseInsensitive() const { return m_header && (m_header->flags & kFlagCaseInsensitive) != 0; }
+
+size_t PropertySnapshot::maxBufferSize() const { return m_header ? static_cast<size_t>(m_header->maxBufferSize) : 0; }
+
+bool PropertySnapshot::matchesSource(const char* data, size_t length) const {
+    return m_header && m_header->sourceSize == length && m_header->sourceChecksum == checksum(data, length);
+}
+
+size_t PropertySnapshot::size() const { return m_header ? static_cast<size_t>(m_header->count) : 0; }
+
+std::string_view PropertySnapshot::name(size_t index) const {
+    const Entry& entry = m_entries[index];
+    if (entry.offset > m_header->textSize || entry.nameLength > m_header->textSize - entry.offset) {
+        return {};
+    }
+    return std::string_view(m_text + entry.offset, entry.nameLength);
+}
+
+std::string_view PropertySnapshot::value(size_t index) const {
+    const Entry& entry = m_entries[index];
+    const uint64_t offset = entry.offset + entry.nameLength;
+    if (entry.offset > m_header->textSize || offset > m_header->textSize || entry.valueLength > m_header->textSize - offset) {
+        return {};
+    }
+    return std::string_view(m_text + offset, entry.valueLength);
+}
+
+bool PropertySnapshot::find(std::string_view name, std::string_view& value) const {
+    value = {};
+    if (!m_header) {
+        return false;
+    }
+
+    const bool fold = isCaseInsensitive();
+    const uint64_t hash = hashFolded(name, fold);
+    const size_t slotCount = m_header->slotCount;
+    const size_t slot = probeHashSlots(m_slots, slotCount, hash, [&](uint32_t index) {
+        if (index >= m_header->count || m_entries[index].hash != hash) {
+            return false;
+        }
+        const std::string_view stored = this->name(index);
+        return fold ? equalsFolded(stored, name) : stored == name;
+    });
+    if (slot == slotCount || m_slots[slot] == 0) {
+        return false;
+    }
+    value = this->value(m_slots[slot] - 1);
+    return true;
+}
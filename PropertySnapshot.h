@@ -0,0 +1,110 @@
+#ifndef PROPERTY_SNAPSHOT_H
+#define PROPERTY_SNAPSHOT_H
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Precompiled binary form of a property file for startup without parsing.
+// A snapshot holds the valid properties of a text exactly as PropertyParser(maxBufferSize,
+// caseInsensitive) reports them: values already trimmed and unescaped, names already folded in
+// case-insensitive mode. The first property with a given name wins, like in findPropertyValue().
+// Properties are found through a hash table stored in the file, so opening a snapshot maps it and
+// checks the header only; lookups read straight from the mapping and do not allocate.
+// The header records a checksum of the source text, which openOrRebuild() uses to detect a stale
+// snapshot. The format is versioned and uses the byte order of the machine that wrote it.
+class PropertySnapshot {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+    PropertySnapshot() = default;
+
+    PropertySnapshot(const PropertySnapshot&) = delete;
+    PropertySnapshot& operator=(const PropertySnapshot&) = delete;
+
+    // Parse a text and return the snapshot image.
+    static std::vector<char> compile(const char* data, size_t length, bool caseInsensitive = false,
+                                     size_t maxBufferSize = kDefaultBufferSize);
+
+    // Compile a text file into a snapshot file. Returns false if either file cannot be accessed.
+    static bool compileFile(const std::string& sourcePath, const std::string& snapshotPath, bool caseInsensitive = false,
+                            size_t maxBufferSize = kDefaultBufferSize);
+
+    // Write an image to a file (through a temporary file that replaces it).
+    static bool write(const std::vector<char>& image, const std::string& path);
+
+    // Checksum of a source text as stored in snapshots.
+    static uint64_t checksum(const char* data, size_t length);
+
+    // Open a snapshot file. Returns false if it cannot be read or is not a valid snapshot.
+    bool open(const std::string& path);
+
+    // Use an image produced by compile().
+    bool open(std::vector<char> image);
+
+    // Open the snapshot of a source text file, compiling it again (and trying to rewrite the
+    // snapshot file) when the snapshot is missing, invalid, built with other options or the source
+    // changed. Returns false only if the source cannot be read either.
+    bool openOrRebuild(const std::string& sourcePath, const std::string& snapshotPath, bool caseInsensitive = false,
+                       size_t maxBufferSize = kDefaultBufferSize);
+
+    void close();
+
+    bool isOpen() const { return m_header != nullptr; }
+    bool isCaseInsensitive() const;
+    size_t maxBufferSize() const;
+
+    // Whether the snapshot was compiled from this text.
+    bool matchesSource(const char* data, size_t length) const;
+
+    // Number of (distinct) properties and access by index in source order.
+    size_t size() const;
+    std::string_view name(size_t index) const;
+    std::string_view value(size_t index) const;
+
+    // Find a property. In case-insensitive mode name may use any case.
+    bool find(std::string_view name, std::string_view& value) const;
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t maxBufferSize;
+        uint64_t sourceSize;
+        uint64_t sourceChecksum;
+        uint64_t count;
+        uint64_t slotCount; // power of two
+        uint64_t slotsOffset;
+        uint64_t entriesOffset;
+        uint64_t textOffset;
+        uint64_t textSize;
+    };
+
+    struct Entry {
+        uint64_t hash;
+        uint64_t offset; // name and value back to back in the text
+        uint32_t nameLength;
+        uint32_t valueLength;
+    };
+
+    static constexpr uint32_t kFlagCaseInsensitive = 1;
+
+    MappedFile m_file;
+    std::vector<char> m_image;
+    const Header* m_header{nullptr};
+    const uint32_t* m_slots{nullptr}; // entry index + 1, 0 for an empty slot
+    const Entry* m_entries{nullptr};
+    const char* m_text{nullptr};
+
+    bool attach(const char* data, size_t size);
+};
+
+#endif // PROPERTY_SNAPSHOT_H
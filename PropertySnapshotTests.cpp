@@ -0,0 +1,80 @@
+#include "PropertySnapshot.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+static void writeText(const std::string& path, const std::string& contents) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+}
+
+TEST(PropertySnapshotTest, CompileAndFind) {
+    const std::string text = "# header\nName = \"x\\\"y\"\nport=80;NAME=other\ninvalid\nlast=1";
+    PropertySnapshot snapshot;
+    ASSERT_TRUE(snapshot.open(PropertySnapshot::compile(text.data(), text.size(), true)));
+    EXPECT_TRUE(snapshot.isCaseInsensitive());
+    EXPECT_TRUE(snapshot.matchesSource(text.data(), text.size()));
+    EXPECT_FALSE(snapshot.matchesSource(text.data(), text.size() - 1));
+
+    ASSERT_EQ(snapshot.size(), 3u);
+    EXPECT_EQ(snapshot.name(0), "name");
+    EXPECT_EQ(snapshot.value(0), "x\"y");
+
+    std::string_view value;
+    ASSERT_TRUE(snapshot.find("NaMe", value));
+    EXPECT_EQ(value, "x\"y"); // the first occurrence wins
+    ASSERT_TRUE(snapshot.find("port", value));
+    EXPECT_EQ(value, "80");
+    ASSERT_TRUE(snapshot.find("last", value));
+    EXPECT_EQ(value, "1");
+    EXPECT_FALSE(snapshot.find("invalid", value));
+    EXPECT_TRUE(value.empty());
+}
+
+TEST(PropertySnapshotTest, RejectsInvalidImages) {
+    PropertySnapshot snapshot;
+    EXPECT_FALSE(snapshot.open(std::vector<char>(16, 'x')));
+
+    const std::string text = "a=1\n";
+    std::vector<char> image = PropertySnapshot::compile(text.data(), text.size());
+    image.resize(image.size() - 1); // truncated text
+    EXPECT_FALSE(snapshot.open(image));
+    EXPECT_FALSE(snapshot.isOpen());
+}
+
+TEST(PropertySnapshotTest, OpenOrRebuild) {
+    const std::string source = ::testing::TempDir() + "prop_parser_snapshot.properties";
+    const std::string snapshotPath = ::testing::TempDir() + "prop_parser_snapshot.bin";
+    std::remove(snapshotPath.c_str());
+    writeText(source, "a=1\nb=2\n");
+
+    PropertySnapshot snapshot;
+    ASSERT_TRUE(snapshot.openOrRebuild(source, snapshotPath));
+    std::string_view value;
+    ASSERT_TRUE(snapshot.find("b", value));
+    EXPECT_EQ(value, "2");
+
+    // the written snapshot is used as it is
+    PropertySnapshot reopened;
+    ASSERT_TRUE(reopened.open(snapshotPath));
+    EXPECT_EQ(reopened.size(), 2u);
+
+    // a changed source is parsed again
+    writeText(source, "a=1\nb=3\n");
+    ASSERT_TRUE(snapshot.openOrRebuild(source, snapshotPath));
+    ASSERT_TRUE(snapshot.find("b", value));
+    EXPECT_EQ(value, "3");
+    ASSERT_TRUE(reopened.open(snapshotPath));
+    ASSERT_TRUE(reopened.find("b", value));
+    EXPECT_EQ(value, "3");
+
+    // other options need another snapshot
+    ASSERT_TRUE(snapshot.openOrRebuild(source, snapshotPath, true));
+    EXPECT_TRUE(snapshot.isCaseInsensitive());
+
+    std::remove(source.c_str());
+    std::remove(snapshotPath.c_str());
+    EXPECT_FALSE(snapshot.openOrRebuild(source, snapshotPath));
+}
@@ -0,0 +1,57 @@
+#include "PropertySnapshot.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// prop_snapshot: compile a property file into a binary snapshot (see PropertySnapshot.h).
+
+namespace {
+
+int usage() {
+    std::fprintf(stderr, "usage: prop_snapshot [-i] [-b buffer_size] <source> <snapshot>\n"
+                         "  -i  case-insensitive names\n"
+                         "  -b  parser buffer size (default %zu)\n",
+                 PropertySnapshot::kDefaultBufferSize);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool caseInsensitive = false;
+    size_t bufferSize = PropertySnapshot::kDefaultBufferSize;
+
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+        if (std::strcmp(argv[arg], "-i") == 0) {
+            caseInsensitive = true;
+        } else if (std::strcmp(argv[arg], "-b") == 0 && arg + 1 < argc) {
+            bufferSize = std::strtoull(argv[++arg], nullptr, 10);
+            if (bufferSize == 0) {
+                return usage();
+            }
+        } else {
+            return usage();
+        }
+    }
+    if (argc - arg != 2) {
+        return usage();
+    }
+
+    const std::string source = argv[arg];
+    const std::string snapshotPath = argv[arg + 1];
+    if (!PropertySnapshot::compileFile(source, snapshotPath, caseInsensitive, bufferSize)) {
+        std::fprintf(stderr, "prop_snapshot: cannot compile %s into %s\n", source.c_str(), snapshotPath.c_str());
+        return 1;
+    }
+
+    PropertySnapshot snapshot;
+    if (!snapshot.open(snapshotPath)) {
+        std::fprintf(stderr, "prop_snapshot: cannot open %s\n", snapshotPath.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu properties\n", snapshotPath.c_str(), snapshot.size());
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "PropertyStore.h"
+
+#include "PropertyParser.h"
+
+void PropertyStore::reserve(size_t properties, size_t bytes) {
+    m_entries.reserve(properties);
+    m_arena.reserve(bytes);
+}
+
+void PropertyStore::add(std::string_view name, std::string_view value) {
+    m_entries.push_back({m_arena.size(), name.size(), value.size()});
+    m_arena.insert(m_arena.end(), name.begin(), name.end());
+    m_arena.insert(m_arena.end(), value.begin(), value.end());
+}
+
+void PropertyStore::add(const PropertyParser& parser) {
+    if (parser.isValid()) {
+        add(parser.getPropertyNameView(), parser.getPropertyValueView());
+    }
+}
+
+void PropertyStore::collect(void* store, const PropertyParser& parser) { static_cast<PropertyStore*>(store)->add(parser); }
+
+void PropertyStore::collectBatch(void* store, const PropertyRecord* records, size_t count) {
+    auto* self = static_cast<PropertyStore*>(store);
+    for (size_t i = 0; i < count; ++i) {
+        if (records[i].valid) {
+            self->add(records[i].name, records[i].value);
+        }
+    }
+}
+
+void PropertyStore::clear() {
+    m_arena.clear();
+    m_entries.clear();
+}
@@ -0,0 +1,60 @@
+#ifndef PROPERTY_STORE_H
+#define PROPERTY_STORE_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+class PropertyParser;
+struct PropertyRecord;
+
+// Valid properties collected from one or more parser feeds. Names and values are appended to a
+// single growing arena and every property is a compact entry of offsets into it, so collecting
+// N properties takes a few allocations instead of 2 * N strings; clear() frees them all at once
+// while keeping the capacity. Views returned by name()/value() are valid until the store is modified.
+class PropertyStore {
+public:
+    PropertyStore() = default;
+
+    // Reserve room for the given number of properties and bytes of names and values.
+    void reserve(size_t properties, size_t bytes);
+
+    void add(std::string_view name, std::string_view value);
+
+    // Add the current record of the parser if it is a valid property.
+    void add(const PropertyParser& parser);
+
+    // Callbacks for feedAndParse() and feedAndParseBatch()/parseParallel(); callbackData is the store.
+    static void collect(void* store, const PropertyParser& parser);
+    static void collectBatch(void* store, const PropertyRecord* records, size_t count);
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    std::string_view name(size_t index) const {
+        const Entry& entry = m_entries[index];
+        return std::string_view(m_arena.data() + entry.offset, entry.nameLength);
+    }
+    std::string_view value(size_t index) const {
+        const Entry& entry = m_entries[index];
+        return std::string_view(m_arena.data() + entry.offset + entry.nameLength, entry.valueLength);
+    }
+
+    // Bytes of names and values held in the arena
+    size_t arenaSize() const { return m_arena.size(); }
+
+    void clear();
+
+private:
+    // Name and value are stored back to back at offset.
+    struct Entry {
+        size_t offset;
+        size_t nameLength;
+        size_t valueLength;
+    };
+
+    std::vector<char> m_arena;
+    std::vector<Entry> m_entries;
+};
+
+#endif // PROPERTY_STORE_H
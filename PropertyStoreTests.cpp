@@ -0,0 +1,45 @@
+#include "PropertyParser.h"
+#include "PropertyStore.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+
+TEST(PropertyStoreTest, CollectsValidProperties) {
+    PropertyStore store;
+    PropertyParser parser(1024, false);
+
+    const char* src = "a=1\ninvalid\nq=\"x y\"\n";
+    parser.feedAndParse(src, std::strlen(src), PropertyStore::collect, &store);
+    parser.feedAndParse("b", 1, PropertyStore::collect, &store);
+    parser.feedAndParse("=2\n", 3, PropertyStore::collect, &store);
+
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.name(0), "a");
+    EXPECT_EQ(store.value(0), "1");
+    EXPECT_EQ(store.name(1), "q");
+    EXPECT_EQ(store.value(1), "x y");
+    EXPECT_EQ(store.name(2), "b");
+    EXPECT_EQ(store.value(2), "2");
+    EXPECT_EQ(store.arenaSize(), 8u);
+
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(store.arenaSize(), 0u);
+}
+
+TEST(PropertyStoreTest, CollectsBatches) {
+    PropertyStore store;
+    store.reserve(2, 16);
+    store.add("first", "");
+
+    PropertyParser parser(1024, true);
+    const char* src = "A=1;B=2;invalid;";
+    parser.feedAndParseBatch(src, std::strlen(src), PropertyStore::collectBatch, &store);
+
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.name(0), "first");
+    EXPECT_EQ(store.value(0), "");
+    EXPECT_EQ(store.name(1), "a");
+    EXPECT_EQ(store.name(2), "b");
+    EXPECT_EQ(store.value(2), "2");
+}
@@ -0,0 +1,184 @@
+#include "PropertyWatcher.h"
+
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#define PROPERTY_WATCHER_INOTIFY 1
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+PropertyWatcher::PropertyWatcher(std::string path, bool caseInsensitive, size_t maxBufferSize)
+    : m_path(std::move(path)), m_caseInsensitive(caseInsensitive), m_maxBufferSize(maxBufferSize) {}
+
+namespace {
+
+// The file is copied rather than mapped (MappedFile): another process may truncate it while it is
+// being compiled, which would fault on the vanished pages of a mapping.
+bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+} // namespace
+
+bool PropertyWatcher::reload() {
+    std::lock_guard<std::mutex> lock(m_reloadMutex);
+    std::string contents;
+    if (!readFile(m_path, contents)) {
+        return false;
+    }
+    const std::shared_ptr<const PropertySnapshot> current = snapshot();
+    if (current && current->matchesSource(contents.data(), contents.size())) {
+        return true;
+    }
+
+    auto next = std::make_shared<PropertySnapshot>();
+    if (!next->open(PropertySnapshot::compile(contents.data(), contents.size(), m_caseInsensitive, m_maxBufferSize))) {
+        return false;
+    }
+    std::atomic_store(&m_snapshot, std::shared_ptr<const PropertySnapshot>(std::move(next)));
+    // Published after the snapshot: a reader that sees the new version also sees the new snapshot.
+    m_version.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+// May lock: libstdc++ guards atomic shared_ptr access with a mutex pool. Reader calls it only for a new version.
+std::shared_ptr<const PropertySnapshot> PropertyWatcher::snapshot() const { return std::atomic_load(&m_snapshot); }
+
+bool PropertyWatcher::start() {
+    if (isRunning()) {
+        return false;
+    }
+    m_stopping = false;
+
+#ifdef PROPERTY_WATCHER_INOTIFY
+    // Watch the directory: a file replaced by rename() keeps being watched. The watch is set up before
+    // the first load, so a change made while loading is queued and picked up by the thread.
+    if (!m_polling) {
+        const size_t slash = m_path.rfind('/');
+        const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : m_path.substr(0, slash));
+        m_watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_watchFd < 0 || inotify_add_watch(m_watchFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0 ||
+            pipe2(m_stopPipe, O_CLOEXEC) != 0) {
+            // Typically out of inotify instances or watches (EMFILE, ENOSPC): poll instead.
+            closeWatch();
+        }
+    }
+#endif
+
+    if (!reload()) {
+        closeWatch();
+        return false;
+    }
+    m_thread = std::thread(&PropertyWatcher::watch, this);
+    return true;
+}
+
+void PropertyWatcher::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    m_stopping = true;
+#ifdef PROPERTY_WATCHER_INOTIFY
+    if (m_stopPipe[1] >= 0) {
+        const char wake = 0;
+        (void)!write(m_stopPipe[1], &wake, 1);
+    }
+#endif
+    m_thread.join();
+    closeWatch();
+}
+
+void PropertyWatcher::closeWatch() {
+#ifdef PROPERTY_WATCHER_INOTIFY
+    for (int* fd : {&m_watchFd, &m_stopPipe[0], &m_stopPipe[1]}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+}
+
+void PropertyWatcher::watch() {
+#ifdef PROPERTY_WATCHER_INOTIFY
+    const size_t slash = m_path.rfind('/');
+    const std::string name = slash == std::string::npos ? m_path : m_path.substr(slash + 1);
+    std::vector<char> events(64 * 1024);
+    while (m_watchFd >= 0 && !m_stopping) {
+        pollfd fds[2] = {{m_watchFd, POLLIN, 0}, {m_stopPipe[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            continue;
+        }
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            break;
+        }
+
+        // Drain everything queued, then reload once.
+        bool changed = false;
+        ssize_t size;
+        while ((size = read(m_watchFd, events.data(), events.size())) > 0 || (size < 0 && errno == EINTR)) {
+            for (ssize_t offset = 0; offset < size;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(events.data() + offset);
+                changed = changed || (event->len > 0 && name == event->name);
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (changed) {
+            reload();
+        }
+        if (size < 0 && errno != EAGAIN) {
+            break;
+        }
+    }
+    // Leaving the loop without a stop request means inotify is not set up or failed: poll instead.
+#endif
+    pollFile();
+}
+
+void PropertyWatcher::pollFile() {
+    while (!m_stopping) {
+        for (int waited = 0; waited < kPollIntervalMs && !m_stopping; waited += 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (!m_stopping) {
+            reload();
+        }
+    }
+}
+
+bool PropertyWatcher::Reader::get(std::string_view name, std::string_view& value) {
+    const PropertySnapshot* snapshot = current();
+    if (!snapshot) {
+        value = {};
+        return false;
+    }
+    return snapshot->find(name, value);
+}
+
+const PropertySnapshot* PropertyWatcher::Reader::current() {
+    const uint64_t version = m_watcher.version();
+    if (version != m_version) {
+        m_snapshot = m_watcher.snapshot();
+        m_version = version;
+    }
+    return m_snapshot.get();
+}
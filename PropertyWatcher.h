@@ -0,0 +1,96 @@
+#ifndef PROPERTY_WATCHER_H
+#define PROPERTY_WATCHER_H
+
+#include "PropertySnapshot.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Hot reload of a property file. The file is parsed into an immutable PropertySnapshot that is
+// published through an atomic shared pointer; a background thread watches the file (inotify on
+// Linux, polling elsewhere) and publishes a new snapshot whenever its contents change. snapshot()
+// hands out the current snapshot, which stays valid as long as it is referenced. The atomic
+// shared_ptr functions are not lock-free in libstdc++ (they take a lock from a small mutex pool), so
+// a Reader only calls them when version() says a new snapshot was published: get() is lock-free
+// while the file is unchanged and briefly takes that lock once per new snapshot.
+// Editors that replace the file (write a temporary file and rename it) are supported.
+class PropertyWatcher {
+public:
+    // Interval at which the file is checked where inotify is not available or has failed.
+    static constexpr int kPollIntervalMs = 1000;
+
+    explicit PropertyWatcher(std::string path, bool caseInsensitive = false,
+                             size_t maxBufferSize = PropertySnapshot::kDefaultBufferSize);
+    ~PropertyWatcher() { stop(); }
+
+    PropertyWatcher(const PropertyWatcher&) = delete;
+    PropertyWatcher& operator=(const PropertyWatcher&) = delete;
+
+    // Load the file and start watching it. Returns false if the file cannot be read (nothing is
+    // started then). If inotify cannot be set up, the file is polled instead.
+    bool start();
+    void stop();
+    bool isRunning() const { return m_thread.joinable(); }
+
+    // Check the file every kPollIntervalMs even where inotify is available, e.g. on a network file
+    // system, where inotify does not see changes made on other hosts. Takes effect on the next start().
+    void setPolling(bool polling) { m_polling = polling; }
+    bool isPolling() const { return m_polling; }
+
+    // Read the file now and publish it if its contents changed. Returns false if it cannot be
+    // read; the previous snapshot stays published then.
+    bool reload();
+
+    // Current snapshot, nullptr before the file was loaded.
+    std::shared_ptr<const PropertySnapshot> snapshot() const;
+
+    // Number of snapshots published so far.
+    uint64_t version() const { return m_version.load(std::memory_order_acquire); }
+
+    const std::string& path() const { return m_path; }
+
+    // Per-thread lookup handle. get() costs one atomic load besides the snapshot lookup while no
+    // new snapshot is published, and one snapshot() call to pick up a new one. Values are valid until
+    // the next call that picks up a newer snapshot.
+    class Reader {
+    public:
+        explicit Reader(const PropertyWatcher& watcher) : m_watcher(watcher) {}
+
+        bool get(std::string_view name, std::string_view& value);
+
+        // Snapshot used by get(), refreshed if a newer one was published; nullptr before the first load.
+        const PropertySnapshot* current();
+
+    private:
+        const PropertyWatcher& m_watcher;
+        std::shared_ptr<const PropertySnapshot> m_snapshot;
+        uint64_t m_version{0};
+    };
+
+private:
+    std::string m_path;
+    bool m_caseInsensitive;
+    size_t m_maxBufferSize;
+    bool m_polling{false};
+
+    std::shared_ptr<const PropertySnapshot> m_snapshot; // accessed with std::atomic_load/atomic_store only
+    std::atomic<uint64_t> m_version{0};
+    std::mutex m_reloadMutex; // serializes writers; readers do not take it
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    int m_watchFd{-1};
+    int m_stopPipe[2]{-1, -1};
+
+    void watch();
+    void pollFile();
+    void closeWatch();
+};
+
+#endif // PROPERTY_WATCHER_H
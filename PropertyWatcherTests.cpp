@@ -0,0 +1,184 @@
+#include "PropertyWatcher.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+// Wait until the watcher publishes a version after `version` (the watcher thread reloads asynchronously).
+bool waitForVersion(const PropertyWatcher& watcher, uint64_t version) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (watcher.version() <= version) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(PropertyWatcherTest, ReloadPublishesSnapshots) {
+    const std::string path = ::testing::TempDir() + "prop_parser_watcher_reload.properties";
+    writeFile(path, "a=1\nb=2\n");
+
+    PropertyWatcher watcher(path);
+    EXPECT_EQ(watcher.snapshot(), nullptr);
+    ASSERT_TRUE(watcher.reload());
+    EXPECT_EQ(watcher.version(), 1u);
+    const std::shared_ptr<const PropertySnapshot> first = watcher.snapshot();
+
+    // Same contents: nothing new is published.
+    ASSERT_TRUE(watcher.reload());
+    EXPECT_EQ(watcher.version(), 1u);
+
+    PropertyWatcher::Reader reader(watcher);
+    std::string_view value;
+    ASSERT_TRUE(reader.get("a", value));
+    EXPECT_EQ(value, "1");
+
+    writeFile(path, "a=10\n");
+    ASSERT_TRUE(watcher.reload());
+    EXPECT_EQ(watcher.version(), 2u);
+    ASSERT_TRUE(reader.get("a", value));
+    EXPECT_EQ(value, "10");
+    EXPECT_FALSE(reader.get("b", value));
+
+    // An old snapshot stays usable while it is referenced.
+    ASSERT_TRUE(first->find("b", value));
+    EXPECT_EQ(value, "2");
+
+    // A missing file keeps the last snapshot.
+    std::remove(path.c_str());
+    EXPECT_FALSE(watcher.reload());
+    ASSERT_TRUE(reader.get("a", value));
+    EXPECT_EQ(value, "10");
+
+    PropertyWatcher missing(path);
+    EXPECT_FALSE(missing.start());
+    EXPECT_FALSE(missing.isRunning());
+}
+
+TEST(PropertyWatcherTest, SurvivesRewritesInPlace) {
+    const std::string path = ::testing::TempDir() + "prop_parser_watcher_rewrite.properties";
+    std::string large;
+    for (int i = 0; i < 20000; ++i) {
+        large += "key" + std::to_string(i) + "=value" + std::to_string(i) + "\n";
+    }
+    writeFile(path, large);
+
+    // Another process truncates and rewrites the file while it is being read and compiled.
+    PropertyWatcher watcher(path);
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; !done; ++i) {
+            writeFile(path, i % 2 ? large : "a=1\n");
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        watcher.reload();
+    }
+    done = true;
+    writer.join();
+
+    writeFile(path, "a=2\n");
+    ASSERT_TRUE(watcher.reload());
+    std::string_view value;
+    ASSERT_TRUE(watcher.snapshot()->find("a", value));
+    EXPECT_EQ(value, "2");
+    std::remove(path.c_str());
+}
+
+TEST(PropertyWatcherTest, WatchesFileChanges) {
+    const std::string path = ::testing::TempDir() + "prop_parser_watcher_watch.properties";
+    const std::string temporary = path + ".new";
+    writeFile(path, "mode=initial\n");
+
+    PropertyWatcher watcher(path, true);
+    ASSERT_TRUE(watcher.start());
+    EXPECT_TRUE(watcher.isRunning());
+    EXPECT_EQ(watcher.version(), 1u);
+
+    // Readers look values up concurrently while the file changes.
+    std::atomic<bool> done{false};
+    std::atomic<size_t> lookups{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&] {
+            PropertyWatcher::Reader reader(watcher);
+            std::string_view value;
+            while (!done) {
+                EXPECT_TRUE(reader.get("MODE", value));
+                ++lookups;
+            }
+        });
+    }
+
+    // Overwritten in place
+    writeFile(path, "mode=rewritten\n");
+    ASSERT_TRUE(waitForVersion(watcher, 1));
+    std::string_view value;
+    ASSERT_TRUE(watcher.snapshot()->find("mode", value));
+    EXPECT_EQ(value, "rewritten");
+
+    // Replaced by rename, as editors do
+    const uint64_t version = watcher.version();
+    writeFile(temporary, "mode=renamed\n");
+    ASSERT_EQ(std::rename(temporary.c_str(), path.c_str()), 0);
+    ASSERT_TRUE(waitForVersion(watcher, version));
+    ASSERT_TRUE(watcher.snapshot()->find("Mode", value));
+    EXPECT_EQ(value, "renamed");
+
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_GT(lookups.load(), 0u);
+
+    watcher.stop();
+    EXPECT_FALSE(watcher.isRunning());
+    std::remove(path.c_str());
+}
+
+TEST(PropertyWatcherTest, PollsWithoutInotify) {
+    const std::string path = ::testing::TempDir() + "prop_parser_watcher_poll.properties";
+    const std::string temporary = path + ".new";
+    writeFile(path, "mode=initial\n");
+
+    PropertyWatcher watcher(path);
+    watcher.setPolling(true);
+    ASSERT_TRUE(watcher.start());
+    EXPECT_TRUE(watcher.isPolling());
+    EXPECT_EQ(watcher.version(), 1u);
+
+    writeFile(path, "mode=rewritten\n");
+    ASSERT_TRUE(waitForVersion(watcher, 1));
+    std::string_view value;
+    ASSERT_TRUE(watcher.snapshot()->find("mode", value));
+    EXPECT_EQ(value, "rewritten");
+
+    const uint64_t version = watcher.version();
+    writeFile(temporary, "mode=renamed\n");
+    ASSERT_EQ(std::rename(temporary.c_str(), path.c_str()), 0);
+    ASSERT_TRUE(waitForVersion(watcher, version));
+    ASSERT_TRUE(watcher.snapshot()->find("mode", value));
+    EXPECT_EQ(value, "renamed");
+
+    // stop() does not wait for the rest of the poll interval.
+    const auto stopStart = std::chrono::steady_clock::now();
+    watcher.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::milliseconds(PropertyWatcher::kPollIntervalMs));
+    EXPECT_FALSE(watcher.isRunning());
+    std::remove(path.c_str());
+}